@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "libtoh/bot_scheduler.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: bench_bot_scheduler [--bots N] [--disks N] [--threads N]\n"
+    "                           [--thread-bots N]\n"
+    "  --bots         bots run as coroutines (default 100000)\n"
+    "  --disks        number of disks of every game (default 10)\n"
+    "  --threads      workers of the scheduler (default all cores)\n"
+    "  --thread-bots  bots run one per thread, for comparison\n"
+    "                 (default 2000)\n"};
+
+struct Options {
+  size_t bots{100000};
+  size_t disks{10};
+  size_t threads{max(thread::hardware_concurrency(), 1u)};
+  size_t threadBots{2000};
+};
+
+struct Sample {
+  size_t bots;
+  uint64_t moves;
+  double spawnSeconds;
+  double runSeconds;
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    size_t *target{arg == "--bots"          ? &options.bots
+                   : arg == "--disks"       ? &options.disks
+                   : arg == "--threads"     ? &options.threads
+                   : arg == "--thread-bots" ? &options.threadBots
+                                            : nullptr};
+    if (!target || i + 1 == argc)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.bots == 0 || options.threads == 0 || options.threadBots == 0 ||
+      options.disks > MaxPathDisks)
+    return nullopt;
+  return options;
+}
+
+// Both kinds of bot play the same moves, computed from the move index.
+Bot coroutineBot(const Game &game) {
+  auto disks{game.getTower(Left).size()};
+  for (uint64_t i{0}; i < optimalLength(disks); i += 1)
+    co_yield optimalMove(disks, i);
+}
+
+Sample runCoroutines(const Options &options) {
+  BotScheduler scheduler{options.threads};
+  auto start{steady_clock::now()};
+  for (size_t i{0}; i < options.bots; i += 1)
+    scheduler.spawn(Game{options.disks}, coroutineBot);
+  auto spawned{steady_clock::now()};
+  auto report{scheduler.run()};
+  auto done{steady_clock::now()};
+  return {options.bots, report.moves,
+          duration<double>(spawned - start).count(),
+          duration<double>(done - spawned).count()};
+}
+
+/*
+ * Every bot is a thread playing its own game in a blocking loop. The threads
+ * start together, so the run time includes the context switches between
+ * bots but not their creation.
+ */
+Sample runThreads(const Options &options) {
+  vector<Game> games(options.threadBots, Game{options.disks});
+  atomic<bool> go{false};
+  atomic<uint64_t> moves{0};
+  vector<thread> bots{};
+
+  auto start{steady_clock::now()};
+  for (auto &&game : games) {
+    bots.emplace_back([&] {
+      while (!go.load(memory_order_acquire))
+        this_thread::yield();
+      uint64_t played{0};
+      for (uint64_t i{0}; i < optimalLength(options.disks); i += 1) {
+        auto move{optimalMove(options.disks, i)};
+        game.select(move.from);
+        game.select(move.to);
+        played += game.isSelected(End) ? 1 : 0;
+      }
+      moves.fetch_add(played, memory_order_relaxed);
+    });
+  }
+  auto spawned{steady_clock::now()};
+  go.store(true, memory_order_release);
+  for (auto &&bot : bots)
+    bot.join();
+  auto done{steady_clock::now()};
+  return {options.threadBots, moves.load(),
+          duration<double>(spawned - start).count(),
+          duration<double>(done - spawned).count()};
+}
+
+void report(string_view name, const Sample &sample) {
+  auto moves{static_cast<double>(sample.moves)};
+  auto bots{static_cast<double>(sample.bots)};
+  cout << format("{:<16} {:>8} {:>16.0f} {:>12.1f} {:>14.2f}\n", name,
+                 sample.bots, moves / sample.runSeconds,
+                 1e9 * sample.runSeconds / moves,
+                 1e6 * sample.spawnSeconds / bots);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  cout << format("{} disks, {} moves per bot, {} scheduler threads\n",
+                 options->disks, optimalLength(options->disks),
+                 options->threads);
+  cout << format("{:<16} {:>8} {:>16} {:>12} {:>14}\n", "bots as", "bots",
+                 "moves/s", "ns/move", "spawn us/bot");
+  report("coroutines", runCoroutines(*options));
+  report("threads", runThreads(*options));
+}
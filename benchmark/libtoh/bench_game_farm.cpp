@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: bench_game_farm [--games N] [--disks N] [--threads N]\n"
+    "                       [--rounds N]\n"
+    "  --games    number of games shared by all threads (default 256)\n"
+    "  --disks    number of disks of every game (default 12)\n"
+    "  --threads  highest thread count of the sweep (default all cores)\n"
+    "  --rounds   times every game replays the solution (default 4)\n"};
+
+struct Options {
+  size_t games{256};
+  size_t disks{12};
+  size_t threads{max(thread::hardware_concurrency(), 1u)};
+  size_t rounds{4};
+};
+
+// Games stored back to back; neighbours owned by different threads share
+// cache lines whenever one of them writes its selection or tower pointers.
+struct UnpaddedGame {
+  Game game;
+};
+
+// Every game starts on its own pair of cache lines, so writers never touch a
+// line another thread is using.
+struct alignas(128) PaddedGame {
+  Game game;
+};
+
+struct Sample {
+  size_t threads;
+  double movesPerSecond;
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    size_t *target{arg == "--games"     ? &options.games
+                   : arg == "--disks"   ? &options.disks
+                   : arg == "--threads" ? &options.threads
+                   : arg == "--rounds"  ? &options.rounds
+                                        : nullptr};
+    if (!target || i + 1 == argc)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.games == 0 || options.threads == 0)
+    return nullopt;
+  return options;
+}
+
+void pinToCore(size_t core) {
+#if defined(__linux__)
+  cpu_set_t set{};
+  CPU_ZERO(&set);
+  CPU_SET(core % max(thread::hardware_concurrency(), 1u), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  static_cast<void>(core);
+#endif
+}
+
+/*
+ * Replays the solution on every game of the farm, alternating between moving
+ * the tower to the right and back to the left so no round allocates. Thread
+ * `t` owns the games `t, t + threads, t + 2 * threads, ...`, so adjacent
+ * games always belong to different threads. Each thread creates its own games
+ * first, which keeps their towers on the heap of the owning thread and leaves
+ * the slots in `farm` as the only memory shared between threads.
+ */
+template <typename Slot>
+double runFarm(vector<Slot> &farm, const array<vector<Position>, 2> &plays,
+               size_t disks, size_t threads, size_t rounds) {
+  atomic<size_t> ready{0};
+  atomic<bool> go{false};
+  vector<thread> workers{};
+  for (size_t t{0}; t < threads; t += 1) {
+    workers.emplace_back([&, t] {
+      pinToCore(t);
+      for (size_t i{t}; i < farm.size(); i += threads)
+        farm[i].game = Game{disks};
+      ready.fetch_add(1);
+      while (!go.load(memory_order_acquire))
+        this_thread::yield();
+      for (size_t round{0}; round < rounds; round += 1) {
+        for (size_t i{t}; i < farm.size(); i += threads) {
+          for (auto &&choice : plays[round % 2])
+            farm[i].game.select(choice);
+        }
+      }
+    });
+  }
+
+  while (ready.load() < threads)
+    this_thread::yield();
+  auto start{steady_clock::now()};
+  go.store(true, memory_order_release);
+  for (auto &&worker : workers)
+    worker.join();
+  auto seconds{duration<double>(steady_clock::now() - start).count()};
+
+  auto moves{farm.size() * rounds * plays.front().size() / 2};
+  return static_cast<double>(moves) / seconds;
+}
+
+template <typename Slot>
+vector<Sample> sweep(const Options &options,
+                     const array<vector<Position>, 2> &plays) {
+  vector<size_t> counts{};
+  for (size_t threads{1}; threads < options.threads; threads *= 2)
+    counts.push_back(threads);
+  counts.push_back(options.threads);
+
+  vector<Slot> farm(options.games, Slot{Game{0}});
+  vector<Sample> samples{};
+  for (auto &&threads : counts) {
+    auto rate{runFarm(farm, plays, options.disks, threads, options.rounds)};
+    samples.push_back({threads, rate});
+  }
+  return samples;
+}
+
+void report(string_view name, const vector<Sample> &samples) {
+  cout << format("{}\n{:>8} {:>16} {:>9} {:>11}\n", name, "threads",
+                 "moves/s", "speedup", "efficiency");
+  auto base{samples.front().movesPerSecond};
+  for (auto &&sample : samples) {
+    auto speedup{sample.movesPerSecond / base};
+    cout << format("{:>8} {:>16.0f} {:>8.2f}x {:>10.1f}%\n", sample.threads,
+                   sample.movesPerSecond, speedup,
+                   100.0 * speedup / static_cast<double>(sample.threads));
+  }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  array<vector<Position>, 2> plays{};
+  solveToh(plays[0], options->disks, Left, Middle, Right);
+  solveToh(plays[1], options->disks, Right, Middle, Left);
+
+  cout << format("{} games of {} disks, {} rounds, sizeof(Game) = {} bytes\n",
+                 options->games, options->disks, options->rounds,
+                 sizeof(Game));
+  report(format("unpadded ({} bytes per slot)", sizeof(UnpaddedGame)),
+         sweep<UnpaddedGame>(*options, plays));
+  report(format("padded ({} bytes per slot)", sizeof(PaddedGame)),
+         sweep<PaddedGame>(*options, plays));
+}
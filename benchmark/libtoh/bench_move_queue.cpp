@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "libtoh/move_queue.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: bench_move_queue [--producers N] [--moves N] [--disks N]\n"
+    "  --producers  the largest number of producers (default all cores)\n"
+    "  --moves      moves submitted by each producer (default 1000000)\n"
+    "  --disks      number of disks of the shared game (default 10)\n"};
+
+struct Options {
+  size_t producers{max(thread::hardware_concurrency(), 1u)};
+  size_t moves{1000000};
+  size_t disks{10};
+};
+
+struct Sample {
+  uint64_t moves;
+  uint64_t accepted;
+  double seconds;
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    size_t *target{arg == "--producers" ? &options.producers
+                   : arg == "--moves"   ? &options.moves
+                   : arg == "--disks"   ? &options.disks
+                                        : nullptr};
+    if (!target || i + 1 == argc)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.producers == 0 || options.moves == 0 ||
+      options.disks > MaxPathDisks)
+    return nullopt;
+  return options;
+}
+
+/*
+ * Every producer plays the optimal solution over and over, so the shared
+ * game sees a mix of legal moves and moves another producer already made.
+ * The applier runs on its own thread; the time runs from the first submit to
+ * the last result.
+ */
+Sample run(const Options &options, size_t producers) {
+  MoveQueue queue{Game{options.disks}, producers};
+  vector<uint64_t> accepted(producers, 0);
+  auto length{optimalLength(options.disks)};
+
+  auto start{steady_clock::now()};
+  {
+    jthread applier{[&](stop_token stop) {
+      while (!stop.stop_requested())
+        if (queue.drain() == 0)
+          this_thread::yield();
+    }};
+    vector<jthread> players{};
+    for (size_t i{0}; i < producers; i += 1) {
+      players.emplace_back([&, i] {
+        auto &player{queue.producer(i)};
+        uint64_t submitted{0};
+        uint64_t polled{0};
+        while (polled < options.moves) {
+          auto moved{false};
+          while (submitted < options.moves &&
+                 player.submit(optimalMove(options.disks,
+                                           length ? submitted % length : 0))) {
+            submitted += 1;
+            moved = true;
+          }
+          while (auto result{player.poll()}) {
+            accepted[i] += result->accepted ? 1 : 0;
+            polled += 1;
+            moved = true;
+          }
+          if (!moved)
+            this_thread::yield();
+        }
+      });
+    }
+  }
+  auto done{steady_clock::now()};
+
+  uint64_t total{0};
+  for (auto &&count : accepted)
+    total += count;
+  return {options.moves * producers, total,
+          duration<double>(done - start).count()};
+}
+
+void report(size_t producers, const Sample &sample) {
+  auto moves{static_cast<double>(sample.moves)};
+  cout << format("{:>10} {:>16.0f} {:>12.1f} {:>12}\n", producers,
+                 moves / sample.seconds, 1e9 * sample.seconds / moves,
+                 sample.accepted);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  cout << format("{} disks, {} moves per producer, one applier\n",
+                 options->disks, options->moves);
+  cout << format("{:>10} {:>16} {:>12} {:>12}\n", "producers", "moves/s",
+                 "ns/move", "accepted");
+  for (size_t producers{1};;
+       producers = min(2 * producers, options->producers)) {
+    report(producers, run(*options, producers));
+    if (producers == options->producers)
+      break;
+  }
+}
@@ -1,9 +1,66 @@
+#include <cmath>
+#include <fstream>
+#include <optional>
+
 #include "benchmark/benchmark.h"
+#include "libtoh/move_log.h"
+#include "libtoh/solution_cache.h"
+#include "libtoh/toh_c.h"
 #include "libtoh/toh_model.h"
 
 using namespace std;
 using namespace toh;
 
+namespace {
+constexpr int64_t MinDisks{1};
+constexpr int64_t MaxDisks{30};
+// A `Position` label is eight bytes, so a 30 disk solution would need 16 GiB.
+// The wide-label sweep stops where the solution still fits in 256 MiB.
+constexpr int64_t MaxWideDisks{24};
+
+// Whether the peak resident set size was reset for the running benchmark.
+bool peakIsReset{false};
+
+// Resets the peak resident set size of the process to its current size, so
+// that a benchmark reports its own peak and not that of the largest before it.
+// Only Linux can; elsewhere no peak is reported.
+void resetPeakResident() {
+#if defined(__linux__)
+  ofstream clear{"/proc/self/clear_refs"};
+  peakIsReset = static_cast<bool>(clear << "5" << flush);
+#endif
+}
+
+// Peak resident set size since resetPeakResident() in bytes, if it was reset.
+optional<double> peakResidentBytes() {
+  if (!peakIsReset)
+    return nullopt;
+  ifstream status{"/proc/self/status"};
+  for (string line{}; getline(status, line);)
+    if (line.starts_with("VmHWM:"))
+      return stod(line.substr(6)) * 1024.0;
+  return nullopt;
+}
+
+// The optimal solution for n disks takes 2^n - 1 moves.
+double exponential(benchmark::IterationCount disks) {
+  return exp2(static_cast<double>(disks));
+}
+
+void reportCounters(benchmark::State &state, size_t moves, size_t bytes) {
+  auto total{static_cast<double>(moves) *
+             static_cast<double>(state.iterations())};
+  state.counters["moves/s"] =
+      benchmark::Counter(total, benchmark::Counter::kIsRate);
+  state.counters["bytes/move"] =
+      static_cast<double>(bytes) / static_cast<double>(moves);
+  if (auto peak{peakResidentBytes()})
+    state.counters["peak_rss"] = benchmark::Counter(
+        *peak, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.SetComplexityN(state.range(0));
+}
+} // namespace
+
 static void BM_Game_Play_3(benchmark::State &state) {
   bool all_finished{true};
   for (auto _ : state) {
@@ -17,3 +74,138 @@ static void BM_Game_Play_3(benchmark::State &state) {
   }
 }
 BENCHMARK(BM_Game_Play_3);
+
+template <typename ChoiceType>
+static void BM_Solve_Toh(benchmark::State &state) {
+  resetPeakResident();
+  auto disks{static_cast<size_t>(state.range(0))};
+  size_t moves{(size_t{1} << disks) - 1};
+  size_t bytes{};
+  for (auto _ : state) {
+    vector<ChoiceType> selections{};
+    solveToh(selections, disks, static_cast<ChoiceType>(Left),
+             static_cast<ChoiceType>(Middle), static_cast<ChoiceType>(Right));
+    bytes = selections.capacity() * sizeof(ChoiceType);
+    benchmark::DoNotOptimize(selections.data());
+    benchmark::ClobberMemory();
+  }
+  reportCounters(state, moves, bytes);
+}
+BENCHMARK(BM_Solve_Toh<Position>)
+    ->DenseRange(MinDisks, MaxWideDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Solve_Toh<uint8_t>)
+    ->DenseRange(MinDisks, MaxDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Solution_Cache(benchmark::State &state) {
+  resetPeakResident();
+  // Large enough to keep every swept solution, so only the first iteration
+  // derives one and the rest measure relabelling cached moves.
+  static SolutionCache cache{size_t{1} << 30};
+  auto disks{static_cast<size_t>(state.range(0))};
+  size_t moves{(size_t{1} << disks) - 1};
+  size_t bytes{};
+  for (auto _ : state) {
+    vector<uint8_t> selections{};
+    cache.solve(selections, disks, uint8_t{Right}, uint8_t{Left},
+                uint8_t{Middle});
+    bytes = selections.capacity() * sizeof(uint8_t);
+    benchmark::DoNotOptimize(selections.data());
+    benchmark::ClobberMemory();
+  }
+  reportCounters(state, moves, bytes);
+}
+BENCHMARK(BM_Solution_Cache)
+    ->DenseRange(MinDisks, MaxDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Game_Replay(benchmark::State &state) {
+  resetPeakResident();
+  auto disks{static_cast<size_t>(state.range(0))};
+  size_t moves{(size_t{1} << disks) - 1};
+  vector<uint8_t> selections{};
+  solveToh(selections, disks, uint8_t{Left}, uint8_t{Middle}, uint8_t{Right});
+
+  bool all_finished{true};
+  for (auto _ : state) {
+    Game game{disks};
+    for (auto &&choice : selections) {
+      game.select(static_cast<Position>(choice));
+    }
+    benchmark::DoNotOptimize(all_finished &= game.isFinished());
+  }
+  reportCounters(state, moves, selections.size() * sizeof(uint8_t));
+}
+BENCHMARK(BM_Game_Replay)
+    ->DenseRange(MinDisks, MaxDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_C_Apply(benchmark::State &state) {
+  resetPeakResident();
+  // BM_Game_Replay through the C interface: one call per game, however long.
+  auto disks{static_cast<size_t>(state.range(0))};
+  size_t moves{};
+  toh_solve(TOH_CLASSIC, disks, nullptr, 0, &moves);
+  vector<uint8_t> solution(2 * moves);
+  toh_solve(TOH_CLASSIC, disks, solution.data(), moves, &moves);
+
+  bool all_finished{true};
+  for (auto _ : state) {
+    auto game{toh_game_create(TOH_CLASSIC, disks)};
+    toh_game_apply(game, solution.data(), moves, nullptr);
+    benchmark::DoNotOptimize(all_finished &= toh_game_is_finished(game) == 1);
+    toh_game_destroy(game);
+  }
+  reportCounters(state, moves, solution.size() * sizeof(uint8_t));
+}
+BENCHMARK(BM_C_Apply)
+    ->DenseRange(MinDisks, MaxWideDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Move_Log_Encode(benchmark::State &state) {
+  resetPeakResident();
+  auto disks{static_cast<size_t>(state.range(0))};
+  vector<Move> moves{};
+  for (uint64_t i{0}; i < optimalLength(disks); i += 1)
+    moves.push_back(optimalMove(disks, i));
+
+  size_t bytes{};
+  for (auto _ : state) {
+    auto log{encodeMoveLog(disks, moves)};
+    bytes = log.size();
+    benchmark::DoNotOptimize(log.data());
+  }
+  reportCounters(state, moves.size(), bytes);
+}
+BENCHMARK(BM_Move_Log_Encode)
+    ->DenseRange(MinDisks, MaxWideDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Move_Log_Read(benchmark::State &state) {
+  resetPeakResident();
+  // Decodes into a small buffer, as a stream consumer would.
+  auto disks{static_cast<size_t>(state.range(0))};
+  vector<Move> moves{};
+  for (uint64_t i{0}; i < optimalLength(disks); i += 1)
+    moves.push_back(optimalMove(disks, i));
+  auto log{encodeMoveLog(disks, moves)};
+
+  vector<Move> buffer(4096);
+  for (auto _ : state) {
+    MoveLogReader reader{log};
+    while (reader.read(buffer) > 0)
+      benchmark::DoNotOptimize(buffer.data());
+  }
+  reportCounters(state, moves.size(), log.size());
+}
+BENCHMARK(BM_Move_Log_Read)
+    ->DenseRange(MinDisks, MaxWideDisks)
+    ->Complexity(exponential)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <optional>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: bench_pty_latency [--toh PATH] [--disks N] [--rounds N]\n"
+    "                         [--rate N] [--quiet MS] [--cols N] [--rows N]\n"
+    "  --toh     the toh executable to launch (default the one built along)\n"
+    "  --disks   number of disks to play with, 1 to 16 (default 10)\n"
+    "  --rounds  times the tower is moved across and back (default 2)\n"
+    "  --rate    keys per second, 0 waits for each frame first (default 0)\n"
+    "  --quiet   idle time in ms that ends a frame, at most half the time\n"
+    "            between two keys (default 3)\n"
+    "  --cols    width of the pseudo-terminal (default 80)\n"
+    "  --rows    height of the pseudo-terminal (default 24)\n"};
+
+constexpr size_t InitialDisks{3};
+// toh takes up to 64 disks, but every move is two keys and every key waits
+// for a paint of about a millisecond: 16 disks already take minutes a round,
+// and each more disk doubles that.
+constexpr size_t MaxDisk{16};
+constexpr auto FrameTimeout{seconds{2}};
+
+struct Options {
+  string toh{TOH_EXECUTABLE};
+  size_t disks{10};
+  size_t rounds{2};
+  size_t rate{0};
+  size_t quiet{3};
+  size_t cols{80};
+  size_t rows{24};
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    if (i + 1 == argc)
+      return nullopt;
+    if (arg == "--toh") {
+      options.toh = argv[i + 1];
+      continue;
+    }
+    size_t *target{arg == "--disks"    ? &options.disks
+                   : arg == "--rounds" ? &options.rounds
+                   : arg == "--rate"   ? &options.rate
+                   : arg == "--quiet"  ? &options.quiet
+                   : arg == "--cols"   ? &options.cols
+                   : arg == "--rows"   ? &options.rows
+                                       : nullptr};
+    if (!target)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.disks == 0 || options.disks > MaxDisk || options.quiet == 0)
+    return nullopt;
+  return options;
+}
+
+/*
+ * Splits the output of the terminal into printable cells and escape
+ * sequences. A frame can only end on the boundary between two sequences, and
+ * cursor position reports requested by the application are answered so it
+ * never stalls waiting for a real terminal.
+ */
+class AnsiScanner {
+public:
+  // Feeds output bytes; returns the replies the terminal owes the program.
+  string feed(string_view bytes) {
+    string replies{};
+    for (auto byte : bytes) {
+      auto c{static_cast<unsigned char>(byte)};
+      switch (m_state) {
+      case State::Ground:
+        if (c == 0x1b) {
+          m_state = State::Escape;
+        } else if (c >= 0x20 && (c < 0x80 || c >= 0xc0)) {
+          m_cells += 1;
+        }
+        break;
+      case State::Escape:
+        m_sequences += 1;
+        m_params.clear();
+        m_state = c == '[' ? State::Csi : c == ']' ? State::Osc : State::Ground;
+        break;
+      case State::Csi:
+        if (c >= 0x40 && c <= 0x7e) {
+          if (c == 'n' && m_params == "6")
+            replies += "\x1b[1;1R";
+          m_state = State::Ground;
+        } else {
+          m_params += byte;
+        }
+        break;
+      case State::Osc:
+        if (c == 0x07 || c == 0x1b)
+          m_state = State::Ground;
+        break;
+      default:
+        break;
+      }
+    }
+    return replies;
+  }
+
+  bool idle() const { return m_state == State::Ground; }
+  size_t cells() const { return m_cells; }
+  size_t sequences() const { return m_sequences; }
+
+private:
+  enum class State { Ground, Escape, Csi, Osc };
+
+  State m_state{State::Ground};
+  string m_params{};
+  size_t m_cells{0};
+  size_t m_sequences{0};
+};
+
+/*
+ * Runs the executable on the slave side of a pseudo-terminal. Output is read
+ * as it arrives and a frame is considered painted once the stream has been
+ * idle for the quiet period outside of an escape sequence; the frame is
+ * timestamped with the arrival of its last byte, so the quiet period itself
+ * is not part of any latency.
+ */
+class PtySession {
+public:
+  explicit PtySession(const Options &options)
+      : m_quiet{milliseconds{options.quiet}} {
+    // Frames answering keys sent at a fixed rate are only told apart if the
+    // stream goes quiet between them.
+    if (options.rate) {
+      auto rep{static_cast<nanoseconds::rep>(options.rate)};
+      m_quiet = min(m_quiet, nanoseconds{seconds{1}} / rep / 2);
+    }
+    winsize size{};
+    size.ws_col = static_cast<unsigned short>(options.cols);
+    size.ws_row = static_cast<unsigned short>(options.rows);
+    m_start = steady_clock::now();
+    m_pid = forkpty(&m_fd, nullptr, nullptr, &size);
+    if (m_pid < 0)
+      throw runtime_error{"forkpty failed"};
+    if (m_pid == 0) {
+      setenv("TERM", "xterm-256color", 1);
+      // A resumed save would start from another disk count than the keys
+      // expect, and quitting would overwrite the save of the user. The clock
+      // would repaint without any key and be taken for the frame of one.
+      execl(options.toh.c_str(), options.toh.c_str(), "--no-save", "--tick",
+            "0", nullptr);
+      _exit(127);
+    }
+  }
+
+  PtySession(const PtySession &) = delete;
+  PtySession &operator=(const PtySession &) = delete;
+
+  ~PtySession() {
+    close(m_fd);
+    if (waitpid(m_pid, nullptr, WNOHANG) == 0) {
+      kill(m_pid, SIGTERM);
+      waitpid(m_pid, nullptr, 0);
+    }
+  }
+
+  steady_clock::time_point start() const { return m_start; }
+  size_t bytes() const { return m_bytes; }
+  bool closed() const { return m_closed; }
+  const AnsiScanner &scanner() const { return m_scanner; }
+
+  steady_clock::time_point send(char key) {
+    auto now{steady_clock::now()};
+    if (write(m_fd, &key, 1) != 1)
+      throw runtime_error{"cannot write to the pseudo-terminal"};
+    return now;
+  }
+
+  // Reads output until a frame ends or the deadline passes; returns the
+  // arrival time of the last byte of the frame.
+  optional<steady_clock::time_point> pump(steady_clock::time_point deadline) {
+    while (!m_closed) {
+      auto now{steady_clock::now()};
+      auto frameEnd{m_last + m_quiet};
+      if (m_inFrame && now >= frameEnd && m_scanner.idle()) {
+        m_inFrame = false;
+        return m_last;
+      }
+      auto until{m_inFrame ? min(deadline, frameEnd) : deadline};
+      if (now >= deadline && until == deadline)
+        return nullopt;
+
+      auto wait{duration_cast<milliseconds>(until - now) + milliseconds{1}};
+      pollfd fd{m_fd, POLLIN, 0};
+      if (poll(&fd, 1, static_cast<int>(wait.count())) <= 0)
+        continue;
+
+      char buffer[4096];
+      auto count{read(m_fd, buffer, sizeof(buffer))};
+      if (count <= 0) {
+        // The slave side reports EIO once the program has exited.
+        m_closed = true;
+        break;
+      }
+      m_last = steady_clock::now();
+      m_inFrame = true;
+      m_bytes += static_cast<size_t>(count);
+      auto replies{
+          m_scanner.feed(string_view{buffer, static_cast<size_t>(count)})};
+      if (!replies.empty() &&
+          write(m_fd, replies.data(), replies.size()) < 0)
+        throw runtime_error{"cannot write to the pseudo-terminal"};
+    }
+    if (m_inFrame) {
+      m_inFrame = false;
+      return m_last;
+    }
+    return nullopt;
+  }
+
+private:
+  int m_fd{-1};
+  pid_t m_pid{-1};
+  nanoseconds m_quiet;
+  steady_clock::time_point m_start{};
+  steady_clock::time_point m_last{};
+  bool m_inFrame{false};
+  bool m_closed{false};
+  size_t m_bytes{0};
+  AnsiScanner m_scanner{};
+};
+
+struct Key {
+  char key;
+  bool completesMove;
+};
+
+struct Result {
+  vector<nanoseconds> latencies{};
+  size_t frames{0};
+  size_t missed{0};
+};
+
+/*
+ * Sends the keys either as soon as the previous key has been painted, or at
+ * a fixed rate. At a fixed rate several keys may be answered by one frame;
+ * every key sent before the last byte of a frame is taken as painted by it.
+ */
+Result play(PtySession &session, const vector<Key> &keys, size_t rate) {
+  Result result{};
+  deque<pair<steady_clock::time_point, bool>> pending{};
+  nanoseconds interval{0};
+  if (rate)
+    interval = nanoseconds{seconds{1}} / static_cast<nanoseconds::rep>(rate);
+  auto next{steady_clock::now()};
+  auto key{keys.begin()};
+
+  while ((key != keys.end() || !pending.empty()) && !session.closed()) {
+    auto now{steady_clock::now()};
+    bool ready{rate ? now >= next : pending.empty()};
+    if (key != keys.end() && ready) {
+      pending.emplace_back(session.send(key->key), key->completesMove);
+      advance(key, 1);
+      next += interval;
+      continue;
+    }
+
+    auto deadline{key != keys.end() && rate ? next : now + FrameTimeout};
+    auto painted{session.pump(deadline)};
+    if (!painted) {
+      if (!pending.empty() &&
+          steady_clock::now() - pending.back().first >= FrameTimeout) {
+        result.missed += pending.size();
+        pending.clear();
+      }
+      continue;
+    }
+    result.frames += 1;
+    while (!pending.empty() && pending.front().first <= *painted) {
+      if (pending.front().second)
+        result.latencies.push_back(*painted - pending.front().first);
+      pending.pop_front();
+    }
+  }
+  return result;
+}
+
+double percentile(const vector<nanoseconds> &sorted, double rank) {
+  if (sorted.empty())
+    return 0.0;
+  auto index{static_cast<size_t>(rank * static_cast<double>(sorted.size()))};
+  return duration<double, micro>(sorted[min(index, sorted.size() - 1)])
+      .count();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  // Resize the game first; these keys are not measured.
+  vector<Key> resize{};
+  for (size_t size{InitialDisks}; size < options->disks; size += 1)
+    resize.push_back({'+', false});
+  for (size_t size{InitialDisks}; size > options->disks; size -= 1)
+    resize.push_back({'-', false});
+
+  vector<Key> moves{};
+  for (size_t round{0}; round < options->rounds; round += 1) {
+    vector<char> choices{};
+    solveToh(choices, options->disks, 'a', 's', 'd');
+    solveToh(choices, options->disks, 'd', 's', 'a');
+    for (size_t i{0}; i < choices.size(); i += 1)
+      moves.push_back({choices[i], i % 2 == 1});
+  }
+
+  try {
+    PtySession session{*options};
+    // The first frame is the first burst that puts text on the screen; mode
+    // switches sent before it do not count.
+    optional<steady_clock::time_point> first{};
+    while (session.scanner().cells() == 0) {
+      first = session.pump(session.start() + FrameTimeout);
+      if (!first)
+        break;
+    }
+    if (!first) {
+      cerr << format("bench_pty_latency: no frame from '{}'", options->toh)
+           << endl;
+      return 1;
+    }
+    auto startup{duration<double, milli>(*first - session.start()).count()};
+
+    play(session, resize, 0);
+    auto bytes{session.bytes()};
+    auto cells{session.scanner().cells()};
+    auto sequences{session.scanner().sequences()};
+    auto start{steady_clock::now()};
+    auto result{play(session, moves, options->rate)};
+    auto seconds{duration<double>(steady_clock::now() - start).count()};
+
+    session.send('q');
+    while (!session.closed() &&
+           session.pump(steady_clock::now() + FrameTimeout)) {
+    }
+
+    auto count{max(result.latencies.size(), size_t{1})};
+    auto perMove{[&](size_t total) {
+      return static_cast<double>(total) / static_cast<double>(count);
+    }};
+    sort(begin(result.latencies), end(result.latencies));
+
+    cout << format("{} moves of {} disks at {}, {}x{} terminal\n",
+                   result.latencies.size(), options->disks,
+                   options->rate ? format("{} keys/s", options->rate)
+                                 : string{"closed loop"},
+                   options->cols, options->rows)
+         << format("startup to first frame: {:.3f} (ms)\n", startup)
+         << format("input to paint p50: {:.1f} p99: {:.1f} p999: {:.1f} "
+                   "max: {:.1f} (us)\n",
+                   percentile(result.latencies, 0.5),
+                   percentile(result.latencies, 0.99),
+                   percentile(result.latencies, 0.999),
+                   percentile(result.latencies, 1.0))
+         << format("bytes/move: {:.0f} cells/move: {:.0f} "
+                   "sequences/move: {:.0f}\n",
+                   perMove(session.bytes() - bytes),
+                   perMove(session.scanner().cells() - cells),
+                   perMove(session.scanner().sequences() - sequences))
+         << format("frames: {} missed: {} throughput: {:.0f} (moves/s)\n",
+                   result.frames, result.missed,
+                   static_cast<double>(result.latencies.size()) / seconds);
+  } catch (const runtime_error &error) {
+    cerr << format("bench_pty_latency: {}", error.what()) << endl;
+    return 1;
+  }
+}
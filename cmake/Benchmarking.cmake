@@ -24,4 +24,10 @@ macro(AddBenchmarks target)
 	target_link_libraries(${target}
 	PRIVATE benchmark::benchmark
 	PRIVATE benchmark::benchmark_main)
+	add_custom_target(benchmark-${target}
+		COMMAND $<TARGET_FILE:${target}>
+			--benchmark_out=${CMAKE_BINARY_DIR}/benchmark-${target}.json
+			--benchmark_out_format=json
+		WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+	)
 endmacro()
@@ -35,10 +35,16 @@ install(FILES "TohConfig.cmake"
 	DESTINATION ${CMAKE_INSTALL_LIBDIR}/toh/cmake
 )
 
-install(TARGETS toh
+install(TARGETS toh toh_puzzles
 	RUNTIME COMPONENT Runtime
 )
 
+if(UNIX)
+	install(TARGETS toh_solve
+		RUNTIME COMPONENT Runtime
+	)
+endif()
+
 set(CPACK_PACKAGE_CONTACT "Mohammad Rahimi <https://github.com/MhmRhm>")
 set(CPACK_PACKAGE_DESCRIPTION "FTowerX: Tower of Hanoi implemented with FTXUI.")
 include(CPack)
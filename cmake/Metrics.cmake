@@ -0,0 +1,9 @@
+include_guard(GLOBAL)
+
+option(TOH_METRICS "Count game and front-end events for Prometheus export" OFF)
+
+function(EnableMetrics target)
+	if(TOH_METRICS)
+		target_compile_definitions(${target} PUBLIC TOH_ENABLE_METRICS)
+	endif()
+endfunction()
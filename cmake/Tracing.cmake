@@ -0,0 +1,9 @@
+include_guard(GLOBAL)
+
+option(TOH_TRACING "Record scoped trace zones as Chrome trace events" OFF)
+
+function(EnableTracing target)
+	if(TOH_TRACING)
+		target_compile_definitions(${target} PUBLIC TOH_ENABLE_TRACING)
+	endif()
+endfunction()
@@ -0,0 +1,148 @@
+#include "libtoh/bot_scheduler.h"
+
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+using namespace toh;
+
+template <typename GameType>
+BasicBotScheduler<GameType>::BasicBotScheduler(size_t workers)
+    : m_workers{workers}, m_queues{make_unique<Queue[]>(workers)} {
+  if (workers == 0)
+    throw invalid_argument{"a bot scheduler needs a worker"};
+}
+
+template <typename GameType>
+size_t BasicBotScheduler<GameType>::spawn(GameType game,
+                                          const BotFactory &factory) {
+  auto &task{m_tasks.emplace_back(
+      Task{std::move(game), Bot{coroutine_handle<Bot::promise_type>{}}})};
+  task.game.select(End);
+  try {
+    task.bot = factory(task.game);
+    if (!task.bot.handle())
+      throw invalid_argument{"a bot needs a coroutine"};
+  } catch (...) {
+    m_tasks.pop_back();
+    throw;
+  }
+  return m_tasks.size() - 1;
+}
+
+template <typename GameType> BotReport BasicBotScheduler<GameType>::run() {
+  for (auto i{m_next}; i < m_tasks.size(); i += 1)
+    m_queues[i % m_workers].bots.push_back(&m_tasks[i]);
+  m_running = m_tasks.size() - m_next;
+  m_next = m_tasks.size();
+
+  vector<BotReport> reports(m_workers);
+  {
+    vector<jthread> threads{};
+    for (size_t worker{1}; worker < m_workers; worker += 1)
+      threads.emplace_back(
+          [this, worker, &reports] { reports[worker] = work(worker); });
+    reports[0] = work(0);
+  }
+
+  if (m_error)
+    rethrow_exception(exchange(m_error, {}));
+  BotReport total{};
+  for (auto &&report : reports) {
+    total.moves += report.moves;
+    total.rejected += report.rejected;
+    total.finished += report.finished;
+    total.steals += report.steals;
+  }
+  return total;
+}
+
+template <typename GameType>
+const GameType &BasicBotScheduler<GameType>::game(size_t bot) const {
+  return m_tasks.at(bot).game;
+}
+
+template <typename GameType>
+BotReport BasicBotScheduler<GameType>::work(size_t worker) {
+  BotReport report{};
+  auto &queue{m_queues[worker]};
+  while (m_running.load(memory_order_acquire) > 0) {
+    Task *task{nullptr};
+    {
+      lock_guard guard{queue.lock};
+      if (!queue.bots.empty()) {
+        task = queue.bots.front();
+        queue.bots.pop_front();
+      }
+    }
+    if (!task) {
+      if (steal(worker))
+        report.steals += 1;
+      else
+        this_thread::yield();
+      continue;
+    }
+
+    if (play(*task, report)) {
+      m_running.fetch_sub(1, memory_order_release);
+      continue;
+    }
+    lock_guard guard{queue.lock};
+    queue.bots.push_back(task);
+  }
+  return report;
+}
+
+template <typename GameType>
+bool BasicBotScheduler<GameType>::steal(size_t worker) {
+  for (size_t i{1}; i < m_workers; i += 1) {
+    auto &victim{m_queues[(worker + i) % m_workers]};
+    deque<Task *> stolen{};
+    {
+      lock_guard guard{victim.lock};
+      auto count{victim.bots.size() / 2};
+      if (count == 0)
+        continue;
+      auto first{victim.bots.end() - static_cast<ptrdiff_t>(count)};
+      stolen.assign(first, victim.bots.end());
+      victim.bots.erase(first, victim.bots.end());
+    }
+    auto &queue{m_queues[worker]};
+    lock_guard guard{queue.lock};
+    queue.bots.insert(queue.bots.end(), stolen.begin(), stolen.end());
+    return true;
+  }
+  return false;
+}
+
+template <typename GameType>
+bool BasicBotScheduler<GameType>::play(Task &task, BotReport &report) {
+  auto handle{task.bot.handle()};
+  auto &promise{handle.promise()};
+  for (size_t turn{0}; turn < BotQuantum; turn += 1) {
+    handle.resume();
+    if (handle.done())
+      break;
+    promise.moved = playMove(task.game, promise.move);
+    report.moves += promise.moved ? 1 : 0;
+    report.rejected += promise.moved ? 0 : 1;
+  }
+  if (!handle.done())
+    return false;
+
+  if (promise.error) {
+    lock_guard guard{m_errorLock};
+    if (!m_error)
+      m_error = promise.error;
+  } else if (task.game.isFinished()) {
+    report.finished += 1;
+  }
+  // Frees the frame now rather than with the scheduler.
+  task.bot = Bot{coroutine_handle<Bot::promise_type>{}};
+  return true;
+}
+
+template class toh::BasicBotScheduler<Game>;
+template class toh::BasicBotScheduler<CyclicGame>;
+template class toh::BasicBotScheduler<AdjacentGame>;
+template class toh::BasicBotScheduler<BicolorGame>;
@@ -0,0 +1,46 @@
+#include "libtoh/game_snapshot.h"
+
+#include <bit>
+
+using namespace std;
+using namespace toh;
+
+GameSnapshot GameSnapshot::of(const GameBoard &game, uint64_t moves) {
+  GameSnapshot snapshot{};
+  snapshot.moves = moves;
+  for (auto &&position : {Left, Middle, Right}) {
+    for (auto &&disk : game.getTower(position)) {
+      if (disk > MaxSnapshotDisks)
+        throw invalid_argument{"too many disks for a snapshot"};
+      snapshot.towers[position] |= uint64_t{1} << (disk - 1);
+    }
+    if (game.isSelected(position))
+      snapshot.selection = position;
+  }
+  return snapshot;
+}
+
+size_t GameSnapshot::disks() const {
+  size_t count{0};
+  for (auto &&tower : towers)
+    count += static_cast<size_t>(popcount(tower));
+  return count;
+}
+
+GameBoard GameSnapshot::board() const {
+  // A snapshot read from shared memory can hold anything; only towers that
+  // share disks 1 to n between them, once each, index the pegs safely.
+  auto all{towers[Left] | towers[Middle] | towers[Right]};
+  if ((towers[Left] & towers[Middle]) != 0 ||
+      (towers[Left] & towers[Right]) != 0 ||
+      (towers[Middle] & towers[Right]) != 0 || (all & (all + 1)) != 0 ||
+      selection > End)
+    return GameBoard{0};
+
+  vector<Position> pegs(disks(), End);
+  for (auto &&position : {Left, Middle, Right}) {
+    for (auto tower{towers[position]}; tower != 0; tower &= tower - 1)
+      pegs[static_cast<size_t>(countr_zero(tower))] = position;
+  }
+  return GameBoard{pegs, selection};
+}
@@ -0,0 +1,104 @@
+#include "libtoh/game_state.h"
+
+using namespace std;
+using namespace toh;
+
+GameState::GameState(size_t size) {
+  for (size_t i{size}; i > 0; i -= 1) {
+    auto height{size - i + 1};
+    m_towers[Left] = make_shared<const Disk>(Disk{i, height, m_towers[Left]});
+  }
+}
+
+GameState::GameState(const GameBoard &game) {
+  for (auto &&position : {Left, Middle, Right}) {
+    for (auto &&disk : game.getTower(position)) {
+      m_towers[position] = make_shared<const Disk>(
+          Disk{disk, height(position) + 1, m_towers[position]});
+    }
+    if (game.isSelected(position))
+      m_selection = position;
+  }
+}
+
+GameState::GameState(array<Chain, 3> towers, Position selection)
+    : m_towers{std::move(towers)}, m_selection{selection} {}
+
+bool GameState::operator==(const GameState &other) const {
+  if (m_selection != other.m_selection)
+    return false;
+  for (auto &&position : {Left, Middle, Right}) {
+    if (!equalChains(m_towers[position], other.m_towers[position]))
+      return false;
+  }
+  return true;
+}
+
+bool GameState::equalChains(const Chain &lhs, const Chain &rhs) {
+  auto left{lhs.get()}, right{rhs.get()};
+  while (left != right) {
+    if (!left || !right)
+      return false;
+    if (left->size != right->size || left->height != right->height)
+      return false;
+    left = left->below.get();
+    right = right->below.get();
+  }
+  return true;
+}
+
+GameState GameState::select(Position position) const {
+  if (position == End)
+    return GameState{m_towers, End};
+  if (m_selection == End) {
+    if (m_towers[position])
+      return GameState{m_towers, position};
+  }
+  if (m_selection == position)
+    return GameState{m_towers, End};
+  if (auto moved{move(m_selection, position)})
+    return *std::move(moved);
+  return *this;
+}
+
+optional<GameState> GameState::move(Position from, Position to) const {
+  if (from == End || to == End || !m_towers[from])
+    return nullopt;
+
+  if (m_towers[to]) {
+    if (m_towers[from]->size >= m_towers[to]->size)
+      return nullopt;
+  }
+
+  auto towers{m_towers};
+  towers[to] = make_shared<const Disk>(
+      Disk{m_towers[from]->size, height(to) + 1, m_towers[to]});
+  towers[from] = m_towers[from]->below;
+  return GameState{std::move(towers), End};
+}
+
+bool GameState::isFinished() const {
+  return !m_towers[Left] && !m_towers[Middle];
+}
+
+bool GameState::isSelected(Position position) const {
+  return position == m_selection;
+}
+
+size_t GameState::height(Position position) const {
+  return m_towers[position] ? m_towers[position]->height : 0;
+}
+
+size_t GameState::top(Position position) const {
+  return m_towers[position] ? m_towers[position]->size : 0;
+}
+
+vector<size_t> GameState::getTower(Position position) const {
+  vector<size_t> tower(height(position));
+  auto disk{m_towers[position].get()};
+  for (auto it{rbegin(tower)}; it != rend(tower); advance(it, 1)) {
+    *it = disk->size;
+    disk = disk->below.get();
+  }
+  return tower;
+}
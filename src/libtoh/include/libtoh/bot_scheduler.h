@@ -0,0 +1,326 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "libtoh/optimal_path.h"
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @class Bot
+ * @brief A bot playing one game, written as a C++20 coroutine.
+ *
+ * A bot is any coroutine returning Bot. It observes its game through a
+ * reference it is given when created and plays a move with `co_yield`, which
+ * suspends it until its next turn. The `co_yield` expression evaluates to
+ * whether the move was legal. The bot ends its game by returning.
+ *
+ * Bots are driven by a BasicBotScheduler; a suspended bot is a heap-allocated
+ * coroutine frame of a few hundred bytes, not a thread.
+ *
+ * ### Example
+ * ```cpp
+ * #include "libtoh/bot_scheduler.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * Bot solver(const Game &game) {
+ *   vector<Position> plays{};
+ *   solveToh(plays, game.getTower(Left).size(), Left, Middle, Right);
+ *   for (size_t i{0}; i < plays.size(); i += 2)
+ *     co_yield Move{plays[i], plays[i + 1]};
+ * }
+ *
+ * int main() {
+ *   BotScheduler scheduler{4};
+ *   for (size_t i{0}; i < 10000; i += 1)
+ *     scheduler.spawn(Game{10}, solver);
+ *   return scheduler.run().finished == 10000 ? 0 : 1;
+ * }
+ * ```
+ */
+class Bot {
+public:
+  /**
+   * @struct Turn
+   * @brief The awaiter of `co_yield`; resumes the bot with the outcome of its
+   * move.
+   */
+  struct Turn {
+    const bool &moved; ///< Whether the move was legal.
+
+    /**
+     * @brief Never ready; a move always ends the turn.
+     * @return false.
+     */
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Suspends the bot until the scheduler has played its move.
+     */
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+    /**
+     * @brief Gets the outcome of the move.
+     * @return true if the move was legal and played.
+     */
+    [[nodiscard]] bool await_resume() const noexcept { return moved; }
+  };
+
+  /**
+   * @struct promise_type
+   * @brief The promise of a bot coroutine.
+   */
+  struct promise_type {
+    Move move{};                ///< The move yielded last.
+    bool moved{false};          ///< Whether that move was legal.
+    std::exception_ptr error{}; ///< The exception that ended the bot, if any.
+
+    /**
+     * @brief Creates the bot owning the coroutine.
+     * @return The bot.
+     */
+    Bot get_return_object() {
+      return Bot{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    /**
+     * @brief Suspends a new bot until its first turn.
+     * @return An awaiter that always suspends.
+     */
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /**
+     * @brief Keeps a finished bot until its owner destroys it.
+     * @return An awaiter that always suspends.
+     */
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    /**
+     * @brief Plays a move and ends the turn.
+     * @param next The move.
+     * @return The awaiter resuming the bot on its next turn.
+     */
+    Turn yield_value(Move next) noexcept {
+      move = next;
+      return Turn{moved};
+    }
+
+    /**
+     * @brief Ends the bot.
+     */
+    void return_void() noexcept {}
+
+    /**
+     * @brief Ends the bot with the exception it threw.
+     */
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+  };
+
+  /**
+   * @brief Takes ownership of a coroutine.
+   * @param handle The coroutine.
+   */
+  explicit Bot(std::coroutine_handle<promise_type> handle) noexcept
+      : m_handle{handle} {}
+
+  /**
+   * @brief Move constructor.
+   * @param src The bot to take the coroutine of.
+   */
+  Bot(Bot &&src) noexcept : m_handle{std::exchange(src.m_handle, {})} {}
+
+  /**
+   * @brief Move assignment operator.
+   * @param src The bot to take the coroutine of.
+   * @return A reference to this bot.
+   */
+  Bot &operator=(Bot &&src) noexcept {
+    if (this != &src) {
+      reset();
+      m_handle = std::exchange(src.m_handle, {});
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destroys the coroutine.
+   */
+  ~Bot() { reset(); }
+
+  /**
+   * @brief Gets the coroutine.
+   * @return The handle, empty once the bot has been moved from.
+   */
+  [[nodiscard]] std::coroutine_handle<promise_type> handle() const {
+    return m_handle;
+  }
+
+private:
+  /**
+   * @brief Destroys the coroutine, if any.
+   */
+  void reset() noexcept {
+    if (m_handle)
+      m_handle.destroy();
+    m_handle = {};
+  }
+
+private:
+  std::coroutine_handle<promise_type> m_handle; ///< The coroutine.
+};
+
+/**
+ * @brief The number of turns a worker plays of a bot before the next one.
+ */
+inline constexpr size_t BotQuantum{64};
+
+/**
+ * @struct BotReport
+ * @brief What a run of the bots of a scheduler did.
+ */
+struct BotReport {
+  uint64_t moves{0};    ///< Legal moves played.
+  uint64_t rejected{0}; ///< Illegal moves yielded.
+  size_t finished{0};   ///< Bots that left their game finished.
+  size_t steals{0};     ///< Batches of bots taken from another worker.
+};
+
+/**
+ * @class BasicBotScheduler
+ * @brief Plays thousands of bots per thread, cooperatively.
+ *
+ * Every worker thread keeps a queue of bots. It resumes the bot at the front
+ * for up to BotQuantum turns, playing each yielded move on the bot's game,
+ * and puts it back at the end, so the bots of a worker take turns without any
+ * context switch. A worker whose queue runs dry steals half of the queue of
+ * another worker. Queues are only locked once per quantum.
+ *
+ * The scheduler owns the games; a bot and its game never run on two threads
+ * at once, so games need no synchronization.
+ *
+ * @tparam GameType The game type, a toh::BasicGame of any rule policy.
+ */
+template <typename GameType> class BasicBotScheduler {
+public:
+  /// Creates a bot for a game; the game outlives the bot.
+  using BotFactory = std::function<Bot(const GameType &)>;
+
+  /**
+   * @brief Constructs a scheduler.
+   * @param workers The number of worker threads of run().
+   * @throws std::invalid_argument if there are no workers.
+   */
+  explicit BasicBotScheduler(size_t workers);
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source BasicBotScheduler object (unused).
+   */
+  BasicBotScheduler(const BasicBotScheduler &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source BasicBotScheduler object (unused).
+   * @return Deleted.
+   */
+  BasicBotScheduler &operator=(const BasicBotScheduler &src) = delete;
+
+  /**
+   * @brief Adds a bot; call it before run().
+   * @param game The game the bot plays.
+   * @param factory Creates the bot for the game.
+   * @return The index of the bot, for game().
+   * @throws std::invalid_argument if the factory returns an empty bot.
+   */
+  size_t spawn(GameType game, const BotFactory &factory);
+
+  /**
+   * @brief Plays every bot added so far to the end.
+   * @return What the bots did.
+   * @throws The first exception thrown by a bot, after all the others ended.
+   */
+  BotReport run();
+
+  /**
+   * @brief Gets the number of bots added.
+   * @return The number of bots.
+   */
+  [[nodiscard]] size_t size() const { return m_tasks.size(); }
+
+  /**
+   * @brief Gets the game of a bot.
+   * @param bot The index of the bot.
+   * @return The game, as its bot left it after run().
+   */
+  [[nodiscard]] const GameType &game(size_t bot) const;
+
+private:
+  /**
+   * @struct Task
+   * @brief A bot and the game it plays.
+   */
+  struct Task {
+    GameType game; ///< The game.
+    Bot bot;       ///< The bot, created once the game has its final address.
+  };
+
+  /**
+   * @struct Queue
+   * @brief The bots waiting for a worker, on their own cache lines.
+   */
+  struct alignas(64) Queue {
+    std::mutex lock{};         ///< Guards the bots.
+    std::deque<Task *> bots{}; ///< The bots, in turn order.
+  };
+
+  /**
+   * @brief Runs bots on one worker until every bot has ended.
+   * @param worker The index of the worker.
+   * @return What the bots run by the worker did.
+   */
+  BotReport work(size_t worker);
+
+  /**
+   * @brief Takes half of the bots of another worker.
+   * @param worker The index of the thief.
+   * @return true if any bot was taken.
+   */
+  bool steal(size_t worker);
+
+  /**
+   * @brief Plays up to BotQuantum turns of a bot.
+   * @param task The bot and its game.
+   * @param report Receives what the bot did.
+   * @return true if the bot has ended.
+   */
+  bool play(Task &task, BotReport &report);
+
+private:
+  size_t m_workers;                  ///< The number of workers.
+  std::unique_ptr<Queue[]> m_queues; ///< One queue per worker.
+  std::deque<Task> m_tasks{};        ///< Every bot and its game.
+  size_t m_next{0};                  ///< The first bot not yet run.
+  std::atomic<size_t> m_running{0};  ///< Bots that have not ended.
+  std::mutex m_errorLock{};          ///< Guards m_error.
+  std::exception_ptr m_error{};      ///< The first exception of a bot.
+};
+
+extern template class BasicBotScheduler<Game>;
+extern template class BasicBotScheduler<CyclicGame>;
+extern template class BasicBotScheduler<AdjacentGame>;
+extern template class BasicBotScheduler<BicolorGame>;
+
+using BotScheduler = BasicBotScheduler<Game>; ///< Bots of the classic game.
+
+} // namespace toh
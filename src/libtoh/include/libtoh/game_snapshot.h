@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @brief The largest number of disks a GameSnapshot can hold.
+ */
+inline constexpr size_t MaxSnapshotDisks{64};
+
+/**
+ * @struct GameSnapshot
+ * @brief A trivially copyable copy of a board, for publishing a game across
+ * threads.
+ *
+ * Each tower is a bit mask of its disks, bit `i - 1` standing for disk `i`,
+ * so the top disk of a tower is its lowest set bit. A snapshot is 40 bytes
+ * and can be copied with memcpy, which makes it suitable for a SeqLock.
+ */
+struct GameSnapshot {
+  std::array<uint64_t, 3> towers{}; ///< The disks of each tower.
+  Position selection{End};          ///< The selected tower.
+  uint64_t moves{};                 ///< The number of moves made so far.
+
+  /**
+   * @brief Takes a snapshot of a board.
+   * @param game The board, with at most MaxSnapshotDisks disks.
+   * @param moves The number of moves made so far.
+   * @return The snapshot.
+   * @throws std::invalid_argument if the board has too many disks.
+   */
+  [[nodiscard]] static GameSnapshot of(const GameBoard &game,
+                                       uint64_t moves = 0);
+
+  /**
+   * @brief Gets the number of disks.
+   * @return The number of disks on all towers.
+   */
+  [[nodiscard]] size_t disks() const;
+
+  /**
+   * @brief Rebuilds the board the snapshot was taken of.
+   * @return A board with the same towers and selection, or a board without
+   * disks if the towers do not hold each of disks 1 to n exactly once or the
+   * selection is not a Position.
+   */
+  [[nodiscard]] GameBoard board() const;
+
+  /**
+   * @brief Equality comparison operator.
+   * @param other The other snapshot to compare.
+   * @return true if both snapshots are equal.
+   */
+  [[nodiscard]] bool operator==(const GameSnapshot &other) const = default;
+};
+
+} // namespace toh
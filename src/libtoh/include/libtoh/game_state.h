@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @class GameState
+ * @brief An immutable Tower of Hanoi state that shares structure with the
+ * states it was derived from.
+ *
+ * Each tower is an immutable chain of disks linked from the top down. Moving
+ * a disk allocates a single chain node on the destination tower while the
+ * source tower simply points one node further down, so every other node is
+ * shared with the parent state. Copying a state copies three pointers, which
+ * makes snapshots O(1) in time and memory and lets thousands of alternative
+ * histories stay alive side by side.
+ *
+ * The selection rules are the same as Game::select, but instead of mutating
+ * the state every operation returns a new one.
+ *
+ * ### Example
+ * ```cpp
+ * #include "libtoh/game_state.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   GameState root{3};
+ *   auto left{root.select(Left).select(Middle)};
+ *   auto right{root.select(Left).select(Right)};
+ *
+ *   // `root`, `left` and `right` are all still valid, independent states.
+ *   return left.getTower(Middle) == right.getTower(Right) ? 0 : 1;
+ * }
+ * ```
+ */
+class GameState {
+public:
+  /**
+   * @brief Constructs the initial state with all disks on the left tower.
+   * @param size The number of disks in the game.
+   */
+  explicit GameState(size_t size);
+
+  /**
+   * @brief Constructs a state equal to the current state of a game.
+   * @param game The game to take the towers and the selection from.
+   */
+  explicit GameState(const GameBoard &game);
+
+  /**
+   * @brief Equality comparison operator.
+   * @param other The other state to compare.
+   * @return true if both states have the same towers and selection.
+   *
+   * Shared sub-chains are recognised by identity, so comparing a state with
+   * a close relative only walks the nodes that differ.
+   */
+  [[nodiscard]] bool operator==(const GameState &other) const;
+
+  /**
+   * @brief Selects a tower by its position.
+   * @param position The position of the tower to select.
+   * @return The state after the selection, following Game::select.
+   */
+  [[nodiscard]] GameState select(Position position) const;
+
+  /**
+   * @brief Moves the top disk of one tower to another.
+   * @param from The position of the tower to move a disk from.
+   * @param to The position of the tower to move the disk to.
+   * @return The state after the move with no tower selected, or an empty
+   * optional if the move breaks the rules of the game.
+   */
+  [[nodiscard]] std::optional<GameState> move(Position from,
+                                              Position to) const;
+
+  /**
+   * @brief Checks if the game is finished.
+   * @return true if all disks are on the right tower, false otherwise.
+   */
+  [[nodiscard]] bool isFinished() const;
+
+  /**
+   * @brief Checks if the specified tower is currently selected.
+   * @param position The position of the tower to check.
+   * @return true if the given tower is selected, false otherwise.
+   */
+  [[nodiscard]] bool isSelected(Position position) const;
+
+  /**
+   * @brief Gets the number of disks on a tower.
+   * @param position The position of the tower.
+   * @return The number of disks on the tower.
+   */
+  [[nodiscard]] size_t height(Position position) const;
+
+  /**
+   * @brief Gets the disk on top of a tower.
+   * @param position The position of the tower.
+   * @return The size of the top disk, or 0 if the tower is empty.
+   */
+  [[nodiscard]] size_t top(Position position) const;
+
+  /**
+   * @brief Gets the disks of a tower.
+   * @param position The position of the tower.
+   * @return The disk sizes from the bottom to the top, as in Game::getTower.
+   *
+   * This copies the tower and takes time linear in its height.
+   */
+  [[nodiscard]] std::vector<size_t> getTower(Position position) const;
+
+private:
+  /**
+   * @struct Disk
+   * @brief An immutable node in the chain of disks of a tower.
+   */
+  struct Disk {
+    size_t size;   ///< The size of this disk.
+    size_t height; ///< The number of disks from this one down to the base.
+    std::shared_ptr<const Disk> below; ///< The disk underneath, if any.
+  };
+
+  using Chain = std::shared_ptr<const Disk>; ///< The top of a tower.
+
+  /**
+   * @brief Constructs a state from its towers and selection.
+   * @param towers The chains of the three towers.
+   * @param selection The selected tower.
+   */
+  GameState(std::array<Chain, 3> towers, Position selection);
+
+  /**
+   * @brief Compares two chains disk by disk.
+   * @param lhs The first chain.
+   * @param rhs The second chain.
+   * @return true if both chains hold the same disks.
+   */
+  static bool equalChains(const Chain &lhs, const Chain &rhs);
+
+private:
+  std::array<Chain, 3> m_towers{};     ///< The towers in the game.
+  Position m_selection{Position::End}; ///< The currently selected tower.
+};
+
+} // namespace toh
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @namespace toh::metrics
+ * @brief Process-wide counters and gauges, exported in the Prometheus text
+ * format.
+ *
+ * Metrics are updated with `TOH_METRICS_INCREMENT(metric)`,
+ * `TOH_METRICS_ADD(metric, delta)` and `TOH_METRICS_SCOPE(metric)`. When the
+ * project is configured with `-DTOH_METRICS=ON` every thread updates its own
+ * cache-line-sized slot with relaxed loads and stores, so updates take no
+ * lock and no read-modify-write; readers sum the slots of all threads.
+ * Otherwise the macros expand to nothing and metrics cost nothing.
+ *
+ * ### Example
+ * ```cpp
+ * #include <iostream>
+ *
+ * #include "libtoh/metrics.h"
+ * #include "libtoh/toh_model.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   Game game{3};
+ *   game.select(Left);
+ *   game.select(Right);
+ *
+ *   metrics::writePrometheus(cout); // toh_moves_total 1, when compiled in
+ * }
+ * ```
+ */
+namespace toh::metrics {
+
+/**
+ * @enum Metric
+ * @brief The metrics of libtoh and the terminal front end.
+ */
+enum class Metric : size_t {
+  Selects,        ///< Counter of calls to BasicGame::select().
+  Moves,          ///< Counter of disks moved by BasicGame::move().
+  RejectedMoves,  ///< Counter of moves refused by BasicGame::move().
+  FramesRendered, ///< Counter of frames rendered by the front ends.
+  EventsHandled,  ///< Counter of events given to a game controller.
+  ActiveSessions, ///< Gauge of games being played.
+};
+
+/**
+ * @brief The number of metrics.
+ */
+inline constexpr size_t MetricCount{
+    static_cast<size_t>(Metric::ActiveSessions) + 1};
+
+/**
+ * @brief Checks whether metrics were compiled in.
+ * @return true if the macros update metrics, false otherwise.
+ */
+[[nodiscard]] constexpr bool isEnabled() {
+#ifdef TOH_ENABLE_METRICS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Reads a metric, summed over all threads.
+ * @param metric The metric.
+ * @return Its value; always 0 when metrics are compiled out.
+ */
+[[nodiscard]] int64_t value(Metric metric);
+
+/**
+ * @brief Writes all metrics in the Prometheus text exposition format.
+ * @param out The stream to write to.
+ *
+ * Nothing is written when metrics are compiled out.
+ */
+void writePrometheus(std::ostream &out);
+
+/**
+ * @brief Rewrites a file with all metrics in the Prometheus text format.
+ *
+ * The metrics are written to `path + ".tmp"`, which is then renamed over the
+ * file, so that a scraper such as the textfile collector of node_exporter
+ * never reads a partial file.
+ *
+ * @param path The path of the file.
+ * @return true on success, false otherwise.
+ */
+bool writePrometheusFile(const std::string &path);
+
+#ifdef TOH_ENABLE_METRICS
+namespace detail {
+/**
+ * @struct Slot
+ * @brief The metrics updated by one thread, alone on its cache line.
+ */
+struct alignas(64) Slot {
+  std::array<std::atomic<int64_t>, MetricCount> values{}; ///< The values.
+};
+
+/**
+ * @brief Creates and registers the slot of a new thread.
+ * @return The slot, which is never freed.
+ */
+Slot *registerSlot();
+
+/**
+ * @brief Updates a metric from the calling thread.
+ * @param metric The metric.
+ * @param delta The amount to add.
+ */
+inline void add(Metric metric, int64_t delta) noexcept {
+  // Registration takes a lock once per thread; updates never do.
+  thread_local Slot *slot{registerSlot()};
+  // Only this thread writes to its slot, so a load and a store suffice.
+  auto &value{slot->values[static_cast<size_t>(metric)]};
+  value.store(value.load(std::memory_order_relaxed) + delta,
+              std::memory_order_relaxed);
+}
+
+/**
+ * @class ScopedGauge
+ * @brief Raises a gauge for its own lifetime.
+ *
+ * Use the `TOH_METRICS_SCOPE` macro instead of constructing it directly, so
+ * that it disappears when metrics are compiled out.
+ */
+class ScopedGauge {
+public:
+  /**
+   * @brief Raises the gauge by one.
+   * @param metric The gauge.
+   */
+  explicit ScopedGauge(Metric metric) noexcept : m_metric{metric} {
+    add(m_metric, 1);
+  }
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source ScopedGauge object (unused).
+   */
+  ScopedGauge(const ScopedGauge &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source ScopedGauge object (unused).
+   * @return Deleted.
+   */
+  ScopedGauge &operator=(const ScopedGauge &src) = delete;
+
+  /**
+   * @brief Lowers the gauge by one.
+   */
+  ~ScopedGauge() { add(m_metric, -1); }
+
+private:
+  Metric m_metric; ///< The gauge.
+};
+} // namespace detail
+
+#define TOH_METRICS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define TOH_METRICS_CONCAT(lhs, rhs) TOH_METRICS_CONCAT_IMPL(lhs, rhs)
+#define TOH_METRICS_ADD(metric, delta)                                         \
+  ::toh::metrics::detail::add(::toh::metrics::Metric::metric, delta)
+#define TOH_METRICS_INCREMENT(metric) TOH_METRICS_ADD(metric, 1)
+#define TOH_METRICS_SCOPE(metric)                                              \
+  const ::toh::metrics::detail::ScopedGauge TOH_METRICS_CONCAT(                \
+      toh_metrics_gauge_, __LINE__) {                                          \
+    ::toh::metrics::Metric::metric                                             \
+  }
+#else
+#define TOH_METRICS_ADD(metric, delta) static_cast<void>(0)
+#define TOH_METRICS_INCREMENT(metric) static_cast<void>(0)
+#define TOH_METRICS_SCOPE(metric) static_cast<void>(0)
+#endif
+
+} // namespace toh::metrics
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "libtoh/optimal_path.h"
+
+namespace toh {
+
+/**
+ * @brief The version written in the header of every encoded move log.
+ *
+ * An encoded log is the magic `TOHL`, the version, the number of disks as a
+ * LEB128 varint and a sequence of tokens, each a varint `value` whose two low
+ * bits give its kind:
+ *
+ * | Tag | Token                                                        |
+ * | --- | ------------------------------------------------------------ |
+ * | 0   | `value >> 2` moves along the optimal path                    |
+ * | 1   | `value >> 2` moves back along the optimal path, undoing them |
+ * | 2   | One explicit move, `from * 3 + to` in the bits above the tag |
+ * | 3   | No move; the index moves `value >> 3` back if bit 2 is set,  |
+ * |     | forwards otherwise                                           |
+ *
+ * The decoder keeps an index into `solveToh(disks, Left, Middle, Right)`:
+ * forward moves advance it, backward moves rewind it, explicit moves leave it
+ * alone and seeks move it to where a detour rejoined the path. Every move of
+ * the path is recomputed from that index by optimalMove(), so perfect play of
+ * any length encodes into a dozen bytes, and a wrong move that is taken back
+ * costs three.
+ *
+ * Every byte of a varint but the last has its high bit set, so a token can
+ * be found by scanning backwards as well as forwards.
+ */
+inline constexpr uint8_t MoveLogVersion{1};
+
+/**
+ * @class MoveLogWriter
+ * @brief Encodes a move log incrementally, as deviations from the optimal
+ * solution.
+ *
+ * Moves on the optimal path only extend the current run. After a move leaves
+ * the path the writer replays the game until it is back on the path, writing
+ * explicit moves in the meantime and a seek if it rejoins at another index;
+ * illegal moves are kept as they are and change nothing.
+ *
+ * ### Example
+ * ```cpp
+ * #include "libtoh/move_log.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   MoveLogWriter writer{20};
+ *   for (uint64_t i{0}; i < optimalLength(20); i += 1)
+ *     writer.append(optimalMove(20, i));
+ *   auto bytes{writer.finish()}; // A million moves in 10 bytes
+ *   return decodeMoveLog(bytes)->size() == optimalLength(20) ? 0 : 1;
+ * }
+ * ```
+ */
+class MoveLogWriter {
+public:
+  /**
+   * @brief Starts a log of a new game.
+   * @param disks The number of disks, at most MaxPathDisks.
+   * @throws std::invalid_argument if there are too many disks.
+   */
+  explicit MoveLogWriter(size_t disks);
+
+  /**
+   * @brief Appends a move.
+   * @param move The move; neither tower may be End.
+   * @throws std::invalid_argument if a tower is End.
+   */
+  void append(Move move);
+
+  /**
+   * @brief Ends the log; call it once, after the last move.
+   * @return The encoded log.
+   */
+  [[nodiscard]] std::vector<uint8_t> finish();
+
+private:
+  /**
+   * @brief Writes the pending run of optimal moves, if any.
+   */
+  void flush();
+
+  /**
+   * @brief Writes the seeks that move the index of the optimal path.
+   * @param index The new index.
+   */
+  void seek(uint64_t index);
+
+  /**
+   * @brief Writes one token.
+   * @param value The count or the move, shifted above the tag.
+   * @param tag The kind of the token.
+   */
+  void writeToken(uint64_t value, uint8_t tag);
+
+private:
+  size_t m_disks;               ///< The number of disks.
+  std::vector<uint8_t> m_bytes; ///< The encoded log so far.
+  uint64_t m_index{0};          ///< The index into the optimal path.
+  uint64_t m_run{0};            ///< Pending moves along the path.
+  bool m_backwards{false};      ///< Whether the pending run goes back.
+  std::optional<Game> m_game{}; ///< The game, while off the path.
+};
+
+/**
+ * @class MoveLogReader
+ * @brief Decodes an encoded move log lazily, in either direction.
+ *
+ * The reader is a cursor between two moves. next() returns the move after it
+ * and moves it forwards; previous() returns the move before it and moves it
+ * back. Only the current token is decoded, so memory use does not depend on
+ * the length of the log.
+ */
+class MoveLogReader {
+public:
+  /**
+   * @brief Opens an encoded log, with the cursor before the first move.
+   * @param bytes The encoded log; must outlive the reader.
+   */
+  explicit MoveLogReader(std::span<const uint8_t> bytes);
+
+  /**
+   * @brief Checks whether the header is valid.
+   * @return false if the log cannot be read.
+   */
+  [[nodiscard]] bool isValid() const { return m_valid; }
+
+  /**
+   * @brief Gets the number of disks of the game.
+   * @return The number of disks.
+   */
+  [[nodiscard]] size_t disks() const { return m_disks; }
+
+  /**
+   * @brief Gets the position of the cursor.
+   * @return The number of moves before the cursor.
+   */
+  [[nodiscard]] uint64_t position() const { return m_position; }
+
+  /**
+   * @brief Checks whether the cursor is after the last move.
+   * @return true at the end of a complete log.
+   */
+  [[nodiscard]] bool atEnd() const;
+
+  /**
+   * @brief Reads the move after the cursor.
+   * @return The move, or an empty optional at the end of the log or on
+   * corrupted data.
+   */
+  std::optional<Move> next();
+
+  /**
+   * @brief Reads the moves after the cursor in bulk; faster than next() for
+   * long runs along the optimal path.
+   * @param moves Receives the moves.
+   * @return The number of moves read, less than `moves.size()` only at the
+   * end of the log or on corrupted data.
+   */
+  size_t read(std::span<Move> moves);
+
+  /**
+   * @brief Reads the move before the cursor.
+   * @return The move, or an empty optional at the start of the log or on
+   * corrupted data.
+   */
+  std::optional<Move> previous();
+
+private:
+  /**
+   * @struct Token
+   * @brief A decoded token and where it lies in the log.
+   */
+  struct Token {
+    size_t begin{0};       ///< The offset of its first byte.
+    size_t end{0};         ///< The offset past its last byte.
+    uint8_t tag{0};        ///< Its kind.
+    uint64_t count{0};     ///< The number of moves it holds.
+    Move move{};           ///< The move of an explicit token.
+    uint64_t distance{0};  ///< How far a seek moves the index.
+    bool backwards{false}; ///< Whether a seek moves the index back.
+  };
+
+  /**
+   * @brief Moves to the next token if the cursor is at the end of the current
+   * one, skipping empty tokens.
+   * @return false at the end of the log or on corrupted data.
+   */
+  bool enterToken();
+
+  /**
+   * @brief Moves the index across a seek.
+   * @param token The seek.
+   * @param forwards Whether the cursor crosses it forwards.
+   * @return false if the index would leave the optimal path.
+   */
+  bool crossSeek(const Token &token, bool forwards);
+
+  /**
+   * @brief Decodes the token starting at an offset.
+   * @param begin The offset of its first byte.
+   * @return The token, or an empty optional if it is truncated or invalid.
+   */
+  std::optional<Token> decodeAt(size_t begin) const;
+
+  /**
+   * @brief Decodes the token ending at an offset.
+   * @param end The offset past its last byte.
+   * @return The token, or an empty optional if there is none.
+   */
+  std::optional<Token> decodeBefore(size_t end) const;
+
+private:
+  std::span<const uint8_t> m_bytes; ///< The encoded log.
+  bool m_valid{false};              ///< Whether the header is valid.
+  size_t m_disks{0};                ///< The number of disks.
+  size_t m_start{0};                ///< The offset of the first token.
+  Token m_token{};                  ///< The token around the cursor.
+  uint64_t m_offset{0};             ///< Moves of m_token before the cursor.
+  uint64_t m_index{0};              ///< The index into the optimal path.
+  uint64_t m_position{0};           ///< Moves before the cursor.
+};
+
+/**
+ * @brief Encodes a whole move log; see MoveLogWriter.
+ * @param disks The number of disks, at most MaxPathDisks.
+ * @param moves The moves played from a new game.
+ * @return The encoded log.
+ */
+[[nodiscard]] std::vector<uint8_t> encodeMoveLog(size_t disks,
+                                                 std::span<const Move> moves);
+
+/**
+ * @brief Decodes a whole move log.
+ * @param bytes The encoded log.
+ * @return The moves, or an empty optional if the log is corrupted.
+ */
+[[nodiscard]] std::optional<std::vector<Move>>
+decodeMoveLog(std::span<const uint8_t> bytes);
+
+} // namespace toh
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "libtoh/optimal_path.h"
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @brief The default number of moves a BasicMoveQueue holds, and the number
+ * of moves each producer may have in flight.
+ */
+inline constexpr size_t MoveQueueCapacity{1024};
+
+/**
+ * @brief The default number of moves BasicMoveQueue::drain() applies at once.
+ */
+inline constexpr size_t MoveBatch{64};
+
+/**
+ * @struct MoveResult
+ * @brief What happened to a move submitted to a BasicMoveQueue.
+ */
+struct MoveResult {
+  uint64_t sequence{0}; ///< The sequence number the producer got for it.
+  Move move{};          ///< The move.
+  uint64_t order{0};    ///< Its place among the moves of every producer.
+  bool accepted{false}; ///< Whether it was legal and played.
+};
+
+/**
+ * @class BasicMoveQueue
+ * @brief Lets several threads play one game through a single applier.
+ *
+ * Producers submit moves to a bounded multi-producer queue: each claims a
+ * cell by advancing the shared tail with a compare-and-swap and publishes it
+ * through the sequence number of the cell, so no producer ever takes a lock.
+ * The applier thread drains the queue in batches, plays every move on the
+ * game it owns and pushes the outcome into a single-producer ring of the
+ * producer that sent it.
+ *
+ * A producer has at most the capacity of the queue in flight, counting the
+ * results it has not polled yet, so the applier never waits for a slow
+ * producer; that producer's submit() fails instead.
+ *
+ * Every Producer must only be used by one thread at a time, and drain() and
+ * game() by the applier thread.
+ *
+ * @tparam GameType The game type, a toh::BasicGame of any rule policy.
+ *
+ * ### Example
+ * ```cpp
+ * #include <thread>
+ *
+ * #include "libtoh/move_queue.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   MoveQueue queue{Game{3}, 2};
+ *   jthread applier{[&](stop_token stop) {
+ *     while (!stop.stop_requested())
+ *       queue.drain();
+ *   }};
+ *   auto &player{queue.producer(0)};
+ *   player.submit({Left, Right});
+ *   while (!player.poll())
+ *     this_thread::yield();
+ * }
+ * ```
+ */
+template <typename GameType> class BasicMoveQueue {
+public:
+  /**
+   * @class Producer
+   * @brief Submits moves and receives their results, from one thread.
+   */
+  class Producer {
+  public:
+    /**
+     * @brief Constructs a producer not yet connected to a queue.
+     */
+    Producer() = default;
+
+    /**
+     * @brief Deleted copy constructor.
+     * @param src The source Producer object (unused).
+     */
+    Producer(const Producer &src) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     * @param src The source Producer object (unused).
+     * @return Deleted.
+     */
+    Producer &operator=(const Producer &src) = delete;
+
+    /**
+     * @brief Submits a move.
+     * @param move The move; it is checked when applied.
+     * @return The sequence number of the move, counting from 0 for each
+     * producer, or std::nullopt if the queue is full or the producer has too
+     * many results to poll.
+     */
+    std::optional<uint64_t> submit(Move move);
+
+    /**
+     * @brief Takes the oldest result not polled yet.
+     * @return The result, or std::nullopt if none is ready.
+     */
+    std::optional<MoveResult> poll();
+
+    /**
+     * @brief Gets the number of moves submitted and not polled yet.
+     * @return The number of moves in flight.
+     */
+    [[nodiscard]] uint64_t pending() const { return m_submitted - m_polled; }
+
+  private:
+    friend class BasicMoveQueue;
+
+    BasicMoveQueue *m_queue{nullptr};          ///< The queue.
+    size_t m_index{0};                         ///< The index of the producer.
+    std::unique_ptr<MoveResult[]> m_results{}; ///< The result ring.
+    uint64_t m_submitted{0};                   ///< Moves submitted.
+    uint64_t m_polled{0};                      ///< Results polled.
+    alignas(64) std::atomic<uint64_t> m_published{0}; ///< Results pushed.
+  };
+
+  /**
+   * @brief Constructs a queue playing a game.
+   * @param game The game; the queue owns it from now on.
+   * @param producers The number of producers.
+   * @param capacity The number of moves the queue holds, rounded up to a
+   * power of two.
+   * @throws std::invalid_argument if there are no producers or no capacity.
+   */
+  BasicMoveQueue(GameType game, size_t producers,
+                 size_t capacity = MoveQueueCapacity);
+
+  /**
+   * @brief Deleted copy constructor.
+   *
+   * The producers refer to the queue.
+   * @param src The source BasicMoveQueue object (unused).
+   */
+  BasicMoveQueue(const BasicMoveQueue &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source BasicMoveQueue object (unused).
+   * @return Deleted.
+   */
+  BasicMoveQueue &operator=(const BasicMoveQueue &src) = delete;
+
+  /**
+   * @brief Gets a producer.
+   * @param index The index of the producer.
+   * @return The producer.
+   */
+  [[nodiscard]] Producer &producer(size_t index);
+
+  /**
+   * @brief Gets the number of producers.
+   * @return The number of producers.
+   */
+  [[nodiscard]] size_t producers() const { return m_producerCount; }
+
+  /**
+   * @brief Applies the moves at the head of the queue and publishes their
+   * results.
+   * @param limit The largest number of moves to apply.
+   * @return The number of moves applied, 0 if the queue was empty.
+   */
+  size_t drain(size_t limit = MoveBatch);
+
+  /**
+   * @brief Gets the game, as the moves drained so far left it.
+   * @return The game.
+   */
+  [[nodiscard]] const GameType &game() const { return m_game; }
+
+private:
+  /**
+   * @struct Cell
+   * @brief A move in the queue and the turn that owns it.
+   *
+   * A cell at position `p` is free for the producer claiming `p` when its
+   * turn is `p`, and holds a move for the applier when its turn is `p + 1`.
+   */
+  struct Cell {
+    std::atomic<uint64_t> turn{0}; ///< Whose turn it is to use the cell.
+    Move move{};                   ///< The move.
+    size_t producer{0};            ///< The producer of the move.
+    uint64_t sequence{0};          ///< Its sequence number.
+  };
+
+  /**
+   * @brief Claims a cell and writes a move into it.
+   * @param producer The index of the producer.
+   * @param sequence The sequence number of the move.
+   * @param move The move.
+   * @return false if the queue is full.
+   */
+  bool push(size_t producer, uint64_t sequence, Move move);
+
+private:
+  GameType m_game;                       ///< The game, owned by the applier.
+  size_t m_producerCount;                ///< The number of producers.
+  size_t m_capacity;                     ///< The number of cells.
+  std::unique_ptr<Cell[]> m_cells;       ///< The queue.
+  std::unique_ptr<Producer[]> m_players; ///< The producers.
+  uint64_t m_head{0};                    ///< The next cell to drain.
+  uint64_t m_order{0};                   ///< Moves drained so far.
+  alignas(64) std::atomic<uint64_t> m_tail{0}; ///< The next cell to claim.
+};
+
+extern template class BasicMoveQueue<Game>;
+extern template class BasicMoveQueue<CyclicGame>;
+extern template class BasicMoveQueue<AdjacentGame>;
+extern template class BasicMoveQueue<BicolorGame>;
+
+using MoveQueue = BasicMoveQueue<Game>;             ///< The classic game.
+using CyclicQueue = BasicMoveQueue<CyclicGame>;     ///< Clockwise moves only.
+using AdjacentQueue = BasicMoveQueue<AdjacentGame>; ///< Neighbouring towers.
+using BicolorQueue = BasicMoveQueue<BicolorGame>;   ///< Two colours of disks.
+
+} // namespace toh
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @brief The largest number of disks whose optimal path can be indexed with
+ * 64-bit move indices.
+ */
+inline constexpr size_t MaxPathDisks{64};
+
+/**
+ * @struct Move
+ * @brief Moves the top disk of one tower onto another.
+ */
+struct Move {
+  Position from{End}; ///< The tower the disk leaves.
+  Position to{End};   ///< The tower the disk lands on.
+
+  /**
+   * @brief Equality comparison operator.
+   * @param other The other move to compare.
+   * @return true if both moves have the same towers.
+   */
+  [[nodiscard]] constexpr bool operator==(const Move &other) const = default;
+
+  /**
+   * @brief Gets the move that undoes this one.
+   * @return The move with both towers swapped.
+   */
+  [[nodiscard]] constexpr Move reversed() const { return {to, from}; }
+};
+
+/**
+ * @brief Plays a move if it is legal, as two selections.
+ *
+ * The game is left with no tower selected, whether the move was played or
+ * refused, so callers only ever see it between moves.
+ *
+ * @tparam GameType The game type, a BasicGame of any rule policy.
+ * @param game The game, with no tower selected.
+ * @param move The move.
+ * @return true if the move was played.
+ */
+template <typename GameType> bool playMove(GameType &game, Move move) {
+  if (move.from >= End || move.to >= End || move.from == move.to ||
+      game.getTower(move.from).empty())
+    return false;
+  game.select(move.from);
+  game.select(move.to);
+  if (game.isSelected(End))
+    return true;
+  game.select(End);
+  return false;
+}
+
+/**
+ * @brief Gets the number of moves of the optimal solution.
+ * @param disks The number of disks, at most MaxPathDisks.
+ * @return `2^disks - 1`.
+ */
+[[nodiscard]] constexpr uint64_t optimalLength(size_t disks) {
+  return disks >= 64 ? ~uint64_t{0} : (uint64_t{1} << disks) - 1;
+}
+
+namespace detail {
+/**
+ * @brief Maps a peg of the closed forms of the optimal path to a tower.
+ *
+ * The closed forms move the tower from peg 0 to peg 2 when the number of
+ * disks is odd and to peg 1 when it is even; swapping the two labels for an
+ * even number of disks always lands it on the right tower.
+ *
+ * @param disks The number of disks.
+ * @param peg The peg, 0, 1 or 2.
+ * @return The tower.
+ */
+[[nodiscard]] constexpr Position pathTower(size_t disks, uint64_t peg) {
+  if (disks % 2 == 0 && peg != 0)
+    peg = 3 - peg;
+  return static_cast<Position>(peg);
+}
+} // namespace detail
+
+/**
+ * @brief Gets a move of `solveToh(disks, Left, Middle, Right)` without
+ * computing the moves before it.
+ *
+ * Move `index` moves disk `countr_zero(index + 1) + 1`, and its towers follow
+ * from the bits of `index + 1` alone, so this takes constant time.
+ *
+ * @param disks The number of disks, at most MaxPathDisks.
+ * @param index The index of the move, less than optimalLength(disks).
+ * @return The move.
+ */
+[[nodiscard]] constexpr Move optimalMove(size_t disks, uint64_t index) {
+  auto move{index + 1};
+  return {detail::pathTower(disks, (move & (move - 1)) % 3),
+          detail::pathTower(disks, ((move | (move - 1)) % 3 + 1) % 3)};
+}
+
+/**
+ * @brief Gets the state reached after a prefix of
+ * `solveToh(disks, Left, Middle, Right)` without replaying it.
+ *
+ * @param disks The number of disks, at most MaxPathDisks.
+ * @param index The number of moves played, at most optimalLength(disks).
+ * @return The tower of each disk, from the smallest disk to the largest, as
+ * taken by the GameBoard constructor.
+ */
+[[nodiscard]] std::vector<Position> optimalState(size_t disks, uint64_t index);
+
+/**
+ * @brief Finds a state on `solveToh(disks, Left, Middle, Right)`, the inverse
+ * of optimalState().
+ *
+ * Walks the disks from the largest down, following the recursion of the
+ * solution: a disk still on the source of its subproblem means its move has
+ * not happened yet, one on the target means the `2^(d-1)` moves before it
+ * have, and one on the spare tower is never on the path. This takes time
+ * linear in the number of disks and never replays a move.
+ *
+ * @param pegs The tower of each disk, from the smallest disk to the largest;
+ * at most MaxPathDisks disks.
+ * @return The number of moves of the path that reach the state, or
+ * std::nullopt if no prefix of the path does.
+ */
+[[nodiscard]] std::optional<uint64_t>
+optimalIndex(const std::vector<Position> &pegs);
+
+/**
+ * @brief Finds the towers of a board on the optimal path of its number of
+ * disks.
+ * @param board The board; its selection is ignored.
+ * @return The number of moves of the path that reach the towers, or
+ * std::nullopt if they are not on it.
+ */
+[[nodiscard]] std::optional<uint64_t> optimalIndex(const GameBoard &board);
+
+} // namespace toh
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "libtoh/optimal_path.h"
+
+namespace toh {
+
+/**
+ * @brief The largest number of disks whose states can be ranked in 64 bits.
+ */
+inline constexpr size_t MaxPuzzleDisks{40};
+
+/**
+ * @brief The version written in the header of every puzzle file.
+ *
+ * A puzzle file is the magic `TOHZ`, the version, the number of disks, two
+ * zero bytes and the number of puzzles as 8 bytes, followed by one record of
+ * PuzzleRecordSize bytes per puzzle: its rank as 8 bytes, then
+ * `distance << 4 | from * 3 + to` as 8 bytes, with 15 in place of the move
+ * of a solved puzzle. Every number is little endian.
+ */
+inline constexpr uint8_t PuzzleFileVersion{1};
+
+/**
+ * @brief The size of the header of a puzzle file.
+ */
+inline constexpr size_t PuzzleHeaderSize{16};
+
+/**
+ * @brief The size of a puzzle in a puzzle file.
+ */
+inline constexpr size_t PuzzleRecordSize{16};
+
+/**
+ * @brief Gets the number of states of a classic game.
+ * @param disks The number of disks, at most MaxPuzzleDisks.
+ * @return `3^disks`; every placement of the disks on the towers is one legal
+ * state, with each tower sorted.
+ */
+[[nodiscard]] constexpr uint64_t puzzleCount(size_t disks) {
+  uint64_t count{1};
+  for (size_t i{0}; i < disks; i += 1)
+    count *= 3;
+  return count;
+}
+
+/**
+ * @struct Puzzle
+ * @brief A state of the classic game, labeled with how to solve it.
+ */
+struct Puzzle {
+  uint64_t rank{0};     ///< The state: disk `d` is on base-3 digit `d - 1`.
+  uint64_t distance{0}; ///< The fewest moves to gather every disk on Right.
+  Move next{};          ///< The first of those moves; End towers if solved.
+
+  /**
+   * @brief Equality comparison operator.
+   * @param other The other puzzle to compare.
+   * @return true if both puzzles are the same and have the same labels.
+   */
+  [[nodiscard]] bool operator==(const Puzzle &other) const = default;
+};
+
+/**
+ * @struct PuzzleCorpus
+ * @brief The content of a puzzle file.
+ */
+struct PuzzleCorpus {
+  size_t disks{0};               ///< The number of disks of every puzzle.
+  std::vector<Puzzle> puzzles{}; ///< The puzzles, in the order written.
+};
+
+/**
+ * @brief Gets the state of a rank.
+ * @param disks The number of disks, at most MaxPuzzleDisks.
+ * @param rank The rank, less than puzzleCount(disks).
+ * @return The tower of each disk, from the smallest disk to the largest, as
+ * taken by the GameBoard constructor.
+ */
+[[nodiscard]] std::vector<Position> unrankPuzzle(size_t disks, uint64_t rank);
+
+/**
+ * @brief Labels a state with its distance to the goal and the optimal move
+ * out of it.
+ *
+ * Walks the disks from the largest down with the tower each must reach: a
+ * disk already there leaves it unchanged, any other must first let the
+ * smaller disks past onto the third tower and costs `2^(d-1)` moves. The
+ * smallest disk that must move is free to, and its move is the next one.
+ * The walk is precomputed for every five disks, so a label of 40 disks takes
+ * eight table lookups and allocates nothing.
+ *
+ * @param disks The number of disks, at most MaxPuzzleDisks.
+ * @param rank The state, less than puzzleCount(disks).
+ * @return The labeled puzzle.
+ */
+[[nodiscard]] Puzzle labelPuzzle(size_t disks, uint64_t rank);
+
+/**
+ * @brief Draws a uniformly random state.
+ *
+ * The state depends only on the seed and the index, so a corpus is the same
+ * whatever the number of threads generating it.
+ *
+ * @param disks The number of disks, at most MaxPuzzleDisks.
+ * @param seed The seed of the corpus.
+ * @param index The index of the puzzle in the corpus.
+ * @return The rank of the state.
+ */
+[[nodiscard]] uint64_t samplePuzzle(size_t disks, uint64_t seed,
+                                    uint64_t index);
+
+/**
+ * @brief Generates, labels and writes a corpus of random puzzles in
+ * parallel.
+ *
+ * Every thread writes its own range of records through its own stream; the
+ * file is written under a temporary name and renamed once complete.
+ *
+ * @param path The path of the file.
+ * @param disks The number of disks, at most MaxPuzzleDisks.
+ * @param count The number of puzzles.
+ * @param seed The seed of the corpus.
+ * @param threads The number of threads, at least 1.
+ * @return true if the file was written.
+ */
+bool writePuzzleFile(const std::string &path, size_t disks, uint64_t count,
+                     uint64_t seed, size_t threads);
+
+/**
+ * @brief Reads a puzzle file.
+ * @param path The path of the file.
+ * @return The puzzles, or std::nullopt if the file is missing, truncated or
+ * not a puzzle file.
+ */
+[[nodiscard]] std::optional<PuzzleCorpus>
+readPuzzleFile(const std::string &path);
+
+} // namespace toh
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @brief The version written in the header of every snapshot.
+ *
+ * A snapshot is laid out as follows, with integers in little endian:
+ *
+ * | Offset | Size          | Content                                      |
+ * | ------ | ------------- | -------------------------------------------- |
+ * | 0      | 4             | The magic `TOHS`                             |
+ * | 4      | 1             | The version                                  |
+ * | 5      | 1             | The variant: classic, cyclic, adjacent, ...  |
+ * | 6      | 1             | The number of disks `n`                      |
+ * | 7      | 1             | The selected tower                           |
+ * | 8      | 8             | The elapsed time in milliseconds             |
+ * | 16     | `ceil(n / 4)` | The tower of each disk, two bits per disk    |
+ * | ...    | 4             | CRC-32 of everything before it               |
+ *
+ * Disk `i` (1-based) is stored in bits `2 * (i - 1) % 8` of byte
+ * `(i - 1) / 4` of the towers. A game of ten disks takes 23 bytes, however
+ * long it has been played.
+ */
+inline constexpr uint8_t SaveStateVersion{1};
+
+/**
+ * @brief The largest game a snapshot can hold, as the number of disks is
+ * stored in a single byte.
+ */
+inline constexpr size_t MaxSaveStateDisks{255};
+
+/**
+ * @struct SaveState
+ * @brief A game restored from a snapshot.
+ * @tparam GameType The game type, a BasicGame of any rule policy.
+ */
+template <typename GameType> struct SaveState {
+  GameType game;                     ///< The restored game.
+  std::chrono::milliseconds elapsed; ///< The time played so far.
+};
+
+namespace detail {
+/**
+ * @struct DecodedState
+ * @brief The fields of a snapshot that passed validation.
+ */
+struct DecodedState {
+  std::vector<Position> pegs;        ///< The tower of each disk.
+  Position selection;                ///< The selected tower.
+  std::chrono::milliseconds elapsed; ///< The time played so far.
+};
+
+/**
+ * @brief Encodes a board into a snapshot.
+ * @param game The board to encode.
+ * @param rule The name of the rule policy of the game.
+ * @param elapsed The time played so far.
+ * @return The snapshot.
+ * @throws std::invalid_argument if the board has more than MaxSaveStateDisks
+ * disks.
+ */
+std::vector<uint8_t> encodeState(const GameBoard &game, std::string_view rule,
+                                 std::chrono::milliseconds elapsed);
+
+/**
+ * @brief Validates and decodes a snapshot.
+ * @param bytes The snapshot.
+ * @param rule The name of the rule policy the snapshot must have been saved
+ * with.
+ * @return The decoded fields, or an empty optional if the snapshot is
+ * truncated, corrupted, of another version or of another variant.
+ */
+std::optional<DecodedState> decodeState(std::span<const uint8_t> bytes,
+                                        std::string_view rule);
+} // namespace detail
+
+/**
+ * @brief Saves a game into a compact snapshot.
+ *
+ * @tparam GameType The game type, a BasicGame of any rule policy.
+ * @param game The game to save.
+ * @param elapsed The time played so far.
+ * @return The snapshot, a few bytes long; see SaveStateVersion.
+ * @throws std::invalid_argument if the game has more than MaxSaveStateDisks
+ * disks.
+ */
+template <typename GameType>
+[[nodiscard]] std::vector<uint8_t>
+serialize(const GameType &game, std::chrono::milliseconds elapsed = {}) {
+  return detail::encodeState(game, GameType::RuleType::Name, elapsed);
+}
+
+/**
+ * @brief Restores a game from a snapshot without replaying any move.
+ *
+ * @tparam GameType The game type, a BasicGame of any rule policy.
+ * @param bytes The snapshot.
+ * @return The restored game and its elapsed time, or an empty optional if the
+ * snapshot is invalid or was saved from another variant.
+ */
+template <typename GameType>
+[[nodiscard]] std::optional<SaveState<GameType>>
+deserialize(std::span<const uint8_t> bytes) {
+  auto state{detail::decodeState(bytes, GameType::RuleType::Name)};
+  if (!state)
+    return std::nullopt;
+  return SaveState<GameType>{GameType{state->pegs, state->selection},
+                             state->elapsed};
+}
+
+/**
+ * @brief Writes a snapshot to a file.
+ *
+ * The snapshot is written next to the file first and renamed over it, so an
+ * interrupted save never leaves a truncated file behind.
+ *
+ * @param path The path of the file.
+ * @param bytes The snapshot.
+ * @return true if the file was written.
+ */
+bool saveToFile(const std::string &path, std::span<const uint8_t> bytes);
+
+/**
+ * @brief Reads a snapshot from a file.
+ * @param path The path of the file.
+ * @return The content of the file, empty if it is missing or larger than any
+ * snapshot can be.
+ */
+[[nodiscard]] std::vector<uint8_t> loadFromFile(const std::string &path);
+
+} // namespace toh
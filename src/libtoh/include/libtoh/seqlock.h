@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+namespace toh {
+
+/**
+ * @class SeqLock
+ * @brief Publishes a value from one writer thread to any number of reader
+ * threads without ever blocking the writer.
+ *
+ * The writer makes the sequence number odd, copies the value and makes the
+ * sequence number even again. A reader copies the value between two reads of
+ * the sequence number and retries if a write overlapped the copy, so readers
+ * only ever spin, and only while a write is in progress.
+ *
+ * The value is stored as relaxed atomic words rather than plain bytes, so an
+ * overlapping copy is a benign retry instead of a data race under the C++
+ * memory model.
+ *
+ * @tparam T The published type; trivially copyable and small, as every read
+ * copies all of it.
+ *
+ * ### Example
+ * ```cpp
+ * #include <thread>
+ *
+ * #include "libtoh/game_snapshot.h"
+ * #include "libtoh/seqlock.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   SeqLock<GameSnapshot> published{};
+ *   jthread writer{[&] {
+ *     Game game{3};
+ *     for (auto &&choice : {Left, Right, Left, Middle}) {
+ *       game.select(choice);
+ *       published.store(GameSnapshot::of(game));
+ *     }
+ *   }};
+ *   return published.load().disks() <= 3 ? 0 : 1;
+ * }
+ * ```
+ */
+template <typename T> class SeqLock {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(std::is_default_constructible_v<T>);
+
+public:
+  /**
+   * @brief Constructs the lock holding an initial value.
+   * @param value The value readers see until the first store().
+   */
+  explicit SeqLock(const T &value = T{}) { store(value); }
+
+  /**
+   * @brief Publishes a new value.
+   *
+   * Must only be called from one thread at a time.
+   * @param value The value to publish.
+   */
+  void store(const T &value) {
+    Words words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    auto sequence{m_sequence.load(std::memory_order_relaxed)};
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i{0}; i < words.size(); i += 1)
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Reads the last published value, retrying while a store() is in
+   * progress.
+   * @return A copy of the value.
+   */
+  [[nodiscard]] T load() const {
+    while (true) {
+      if (auto value{tryLoad()})
+        return *value;
+    }
+  }
+
+  /**
+   * @brief Reads the last published value once.
+   * @return A copy of the value, or an empty optional if a store() overlapped
+   * the read.
+   */
+  [[nodiscard]] std::optional<T> tryLoad() const {
+    auto before{m_sequence.load(std::memory_order_acquire)};
+    if (before % 2 != 0)
+      return std::nullopt;
+    Words words{};
+    for (size_t i{0}; i < words.size(); i += 1)
+      words[i] = m_words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_sequence.load(std::memory_order_relaxed) != before)
+      return std::nullopt;
+
+    T value{};
+    std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+  /**
+   * @brief Gets the number of values published so far.
+   * @return The number of calls to store(), including the one made by the
+   * constructor.
+   */
+  [[nodiscard]] uint64_t version() const {
+    return m_sequence.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr size_t WordCount{(sizeof(T) + 7) / 8};
+  using Words = std::array<uint64_t, WordCount>;
+
+  std::atomic<uint64_t> m_sequence{0}; ///< Odd while a store is in progress.
+  std::array<std::atomic<uint64_t>, WordCount>
+      m_words{}; ///< The value, one word at a time.
+};
+
+} // namespace toh
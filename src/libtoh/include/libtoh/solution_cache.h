@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "libtoh/toh_model.h"
+
+namespace toh {
+
+/**
+ * @class PackedSolution
+ * @brief The canonical solution of `solveToh(n, Left, Middle, Right)` stored
+ * with four bits per move.
+ *
+ * Each move is encoded as `from << 2 | to`, two moves per byte with the even
+ * move in the low nibble. Solutions for other disk counts are derived by
+ * composition instead of recursion:
+ *
+ * - `S(n + 1) = swap(Middle, Right, S(n)) + (Left, Right) +
+ *   swap(Left, Middle, S(n))`
+ * - `S(n - 1) = swap(Middle, Right, first 2^(n-1) - 1 moves of S(n))`
+ */
+class PackedSolution {
+public:
+  /**
+   * @brief Constructs the empty solution for zero disks.
+   */
+  PackedSolution() = default;
+
+  /**
+   * @brief Gets the number of disks this solution moves.
+   * @return The number of disks.
+   */
+  [[nodiscard]] size_t disks() const { return m_disks; }
+
+  /**
+   * @brief Gets the number of moves in the solution.
+   * @return `2^disks - 1`.
+   */
+  [[nodiscard]] size_t size() const { return (size_t{1} << m_disks) - 1; }
+
+  /**
+   * @brief Gets the memory held by the packed moves.
+   * @return The number of bytes.
+   */
+  [[nodiscard]] size_t bytes() const { return m_moves.size(); }
+
+  /**
+   * @brief Gets a packed move.
+   * @param index The index of the move, less than size().
+   * @return The move encoded as `from << 2 | to`.
+   */
+  [[nodiscard]] uint8_t at(size_t index) const {
+    return static_cast<uint8_t>(m_moves[index / 2] >> (index % 2 * 4)) & 0xF;
+  }
+
+  /**
+   * @brief Derives the solution for one more disk.
+   * @return The solution for `disks() + 1` disks.
+   */
+  [[nodiscard]] PackedSolution extend() const;
+
+  /**
+   * @brief Derives the solution for fewer disks.
+   * @param disks The number of disks, at most disks().
+   * @return The solution for `disks` disks.
+   */
+  [[nodiscard]] PackedSolution shrink(size_t disks) const;
+
+private:
+  size_t m_disks{0};              ///< The number of disks.
+  std::vector<uint8_t> m_moves{}; ///< The packed moves.
+};
+
+/**
+ * @class SolutionCache
+ * @brief A thread-safe cache of optimal solutions shared across callers.
+ *
+ * The cache keeps one PackedSolution per disk count. A request for any peg
+ * labelling is answered by relabelling the canonical moves while they are
+ * copied out. A missing disk count is derived from the closest cached one:
+ * by taking a prefix of a larger solution, or by extending a smaller one one
+ * disk at a time. Solutions are evicted in least recently used order once
+ * the cache holds more than its memory budget.
+ *
+ * ### Example
+ * ```cpp
+ * #include "libtoh/solution_cache.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   vector<char> keys{};
+ *   // Computed once, then reused for every labelling and smaller game.
+ *   SolutionCache::instance().solve(keys, 10, 'a', 's', 'd');
+ *   SolutionCache::instance().solve(keys, 9, 'd', 'a', 's');
+ * }
+ * ```
+ */
+class SolutionCache {
+public:
+  static constexpr size_t DefaultMemoryBudget{size_t{64} << 20}; ///< 64 MiB.
+
+  /**
+   * @brief Constructs an empty cache.
+   * @param memoryBudget The number of bytes of packed moves to keep.
+   */
+  explicit SolutionCache(size_t memoryBudget = DefaultMemoryBudget);
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source SolutionCache object (unused).
+   */
+  SolutionCache(const SolutionCache &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source SolutionCache object (unused).
+   * @return Deleted.
+   */
+  SolutionCache &operator=(const SolutionCache &src) = delete;
+
+  /**
+   * @brief Gets the process-wide cache.
+   * @return A reference to the shared cache.
+   */
+  static SolutionCache &instance();
+
+  /**
+   * @brief Appends the optimal solution to `selections`, like solveToh.
+   *
+   * @tparam ChoiceType The type representing the tower.
+   * @param selections A vector to store the source and destination of each
+   * move.
+   * @param disk The number of disks to move.
+   * @param src The source tower.
+   * @param tmp The temporary (auxiliary) tower.
+   * @param dst The destination tower.
+   */
+  template <typename ChoiceType>
+  void solve(std::vector<ChoiceType> &selections, size_t disk, ChoiceType src,
+             ChoiceType tmp, ChoiceType dst) {
+    auto solution{acquire(disk)};
+    const std::array<ChoiceType, 3> labels{src, tmp, dst};
+    selections.reserve(selections.size() + 2 * solution->size());
+    for (size_t i{0}; i < solution->size(); i += 1) {
+      auto move{solution->at(i)};
+      selections.push_back(labels[move >> 2]);
+      selections.push_back(labels[move & 3]);
+    }
+  }
+
+  /**
+   * @brief Gets the canonical solution for a number of disks.
+   * @param disk The number of disks.
+   * @return The shared, immutable solution.
+   */
+  std::shared_ptr<const PackedSolution> acquire(size_t disk);
+
+  /**
+   * @brief Changes the memory budget, evicting solutions if needed.
+   * @param bytes The number of bytes of packed moves to keep.
+   */
+  void setMemoryBudget(size_t bytes);
+
+  /**
+   * @brief Gets the memory held by cached solutions.
+   * @return The number of bytes.
+   */
+  [[nodiscard]] size_t memoryUsage() const;
+
+  /**
+   * @brief Checks whether a solution is cached, without touching its age.
+   * @param disk The number of disks.
+   * @return true if the solution is cached.
+   */
+  [[nodiscard]] bool contains(size_t disk) const;
+
+  /**
+   * @brief Drops every cached solution.
+   */
+  void clear();
+
+private:
+  /**
+   * @struct Entry
+   * @brief A cached solution and its place in the recency list.
+   */
+  struct Entry {
+    std::shared_ptr<const PackedSolution> solution; ///< The solution.
+    std::list<size_t>::iterator age; ///< Position in the recency list.
+  };
+
+  /**
+   * @brief Evicts the least recently used solutions until within budget.
+   *
+   * The caller must hold the lock.
+   */
+  void evict();
+
+private:
+  mutable std::mutex m_lock{};        ///< Guards all members below.
+  std::map<size_t, Entry> m_entries{}; ///< Cached solutions by disk count.
+  std::list<size_t> m_ages{};         ///< Disk counts, most recent first.
+  size_t m_usage{0};                  ///< Bytes held by cached solutions.
+  size_t m_budget;                    ///< The memory budget in bytes.
+};
+
+} // namespace toh
@@ -0,0 +1,234 @@
+#pragma once
+
+/**
+ * @file toh_c.h
+ * @brief A stable C interface to the Tower of Hanoi model for embedding the
+ * library in other languages.
+ *
+ * Games are opaque handles owned by the caller. Only C types cross the
+ * interface and no C++ exception escapes it, so the functions can be bound
+ * directly from any foreign function interface.
+ *
+ * A move is two consecutive bytes, the source and the destination tower. The
+ * batched functions take arrays of moves and check the rules for every move
+ * inside the library, so one call can apply, validate or produce millions of
+ * moves.
+ *
+ * ### Example
+ * ```c
+ * #include <stdlib.h>
+ *
+ * #include "libtoh/toh_c.h"
+ *
+ * int main(void) {
+ *   toh_game *game = toh_game_create(TOH_CLASSIC, 20);
+ *   size_t count = 0, applied = 0;
+ *   toh_solve(TOH_CLASSIC, 20, NULL, 0, &count);
+ *   uint8_t *moves = malloc(2 * count);
+ *   toh_solve(TOH_CLASSIC, 20, moves, count, &count);
+ *   toh_game_apply(game, moves, count, &applied);
+ *   int finished = toh_game_is_finished(game);
+ *   free(moves);
+ *   toh_game_destroy(game);
+ *   return !finished;
+ * }
+ * ```
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(TOH_C_BUILD)
+#define TOH_API __declspec(dllexport)
+#elif defined(TOH_C_STATIC)
+#define TOH_API
+#else
+#define TOH_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define TOH_API __attribute__((visibility("default")))
+#else
+#define TOH_API
+#endif
+
+/**
+ * @brief The version of this interface; changes only when an existing
+ * function or value changes.
+ */
+#define TOH_C_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief An opaque game, created by toh_game_create() and released by
+ * toh_game_destroy().
+ */
+typedef struct toh_game toh_game;
+
+/**
+ * @brief The towers, with the same values as toh::Position.
+ */
+enum toh_tower {
+  TOH_LEFT = 0,   /**< The left tower. */
+  TOH_MIDDLE = 1, /**< The middle tower. */
+  TOH_RIGHT = 2,  /**< The right tower. */
+  TOH_END = 3     /**< No tower. */
+};
+
+/**
+ * @brief The rule variants, as in the `--variant` option of the game.
+ */
+typedef enum toh_variant {
+  TOH_CLASSIC = 0,  /**< toh::ClassicRule. */
+  TOH_CYCLIC = 1,   /**< toh::CyclicRule. */
+  TOH_ADJACENT = 2, /**< toh::AdjacentRule. */
+  TOH_BICOLOR = 3   /**< toh::BicolorRule. */
+} toh_variant;
+
+/**
+ * @brief The result of the functions that can fail.
+ */
+typedef enum toh_status {
+  TOH_OK = 0,                     /**< Success. */
+  TOH_ERROR_ARGUMENT = 1,         /**< A null handle or an invalid value. */
+  TOH_ERROR_ILLEGAL_MOVE = 2,     /**< A move breaks the rules. */
+  TOH_ERROR_BUFFER_TOO_SMALL = 3, /**< The output buffer is too short. */
+  TOH_ERROR_NO_MEMORY = 4         /**< An allocation failed. */
+} toh_status;
+
+/**
+ * @brief Gets the version of the interface the library was built with.
+ * @return TOH_C_API_VERSION of the library.
+ */
+TOH_API int toh_api_version(void);
+
+/**
+ * @brief Creates a game with all disks on the left tower.
+ * @param variant The rules of the game.
+ * @param disks The number of disks.
+ * @return The game, or NULL if the variant is invalid or memory ran out.
+ */
+TOH_API toh_game *toh_game_create(toh_variant variant, size_t disks);
+
+/**
+ * @brief Creates a game from the tower of every disk.
+ * @param variant The rules of the game.
+ * @param pegs The tower of each disk, from the smallest disk to the largest.
+ * @param disks The number of disks.
+ * @return The game with no tower selected, or NULL if a tower is invalid or
+ * memory ran out.
+ */
+TOH_API toh_game *toh_game_create_from_pegs(toh_variant variant,
+                                            const uint8_t *pegs, size_t disks);
+
+/**
+ * @brief Copies a game.
+ * @param game The game to copy.
+ * @return The independent copy, or NULL if `game` is NULL or memory ran out.
+ */
+TOH_API toh_game *toh_game_clone(const toh_game *game);
+
+/**
+ * @brief Releases a game; NULL is ignored.
+ * @param game The game to release.
+ */
+TOH_API void toh_game_destroy(toh_game *game);
+
+/**
+ * @brief Gets the rules of a game.
+ * @param game The game, not NULL.
+ * @return The variant of the game.
+ */
+TOH_API toh_variant toh_game_variant(const toh_game *game);
+
+/**
+ * @brief Gets the number of disks of a game.
+ * @param game The game.
+ * @return The number of disks, 0 if `game` is NULL.
+ */
+TOH_API size_t toh_game_disks(const toh_game *game);
+
+/**
+ * @brief Checks whether all disks are on the right tower.
+ * @param game The game.
+ * @return 1 if the game is finished, 0 otherwise.
+ */
+TOH_API int toh_game_is_finished(const toh_game *game);
+
+/**
+ * @brief Gets the selected tower.
+ * @param game The game.
+ * @return The selected tower, TOH_END if none.
+ */
+TOH_API int toh_game_selection(const toh_game *game);
+
+/**
+ * @brief Gets the tower of every disk.
+ * @param game The game.
+ * @param pegs Receives the tower of each disk, from the smallest disk to the
+ * largest.
+ * @param capacity The number of entries `pegs` can hold.
+ * @return TOH_ERROR_BUFFER_TOO_SMALL if `capacity` is less than
+ * toh_game_disks().
+ */
+TOH_API toh_status toh_game_pegs(const toh_game *game, uint8_t *pegs,
+                                 size_t capacity);
+
+/**
+ * @brief Selects a tower as a player would; see toh::BasicGame::select.
+ * @param game The game.
+ * @param tower The tower to select, or TOH_END to clear the selection.
+ * @return TOH_ERROR_ARGUMENT if the tower is invalid.
+ */
+TOH_API toh_status toh_game_select(toh_game *game, int tower);
+
+/**
+ * @brief Applies moves until the first one that breaks the rules.
+ *
+ * Any pending selection is cleared first. The moves before the illegal one
+ * stay applied.
+ *
+ * @param game The game.
+ * @param moves `count` moves, each a source and a destination tower.
+ * @param count The number of moves.
+ * @param applied Receives the number of moves applied; may be NULL.
+ * @return TOH_ERROR_ILLEGAL_MOVE if not every move could be applied.
+ */
+TOH_API toh_status toh_game_apply(toh_game *game, const uint8_t *moves,
+                                  size_t count, size_t *applied);
+
+/**
+ * @brief Checks moves against a game without changing it.
+ * @param game The game.
+ * @param moves `count` moves, each a source and a destination tower.
+ * @param count The number of moves.
+ * @param valid Receives the number of leading moves that follow the rules;
+ * may be NULL.
+ * @return TOH_ERROR_ILLEGAL_MOVE if a move breaks the rules.
+ */
+TOH_API toh_status toh_game_validate(const toh_game *game,
+                                     const uint8_t *moves, size_t count,
+                                     size_t *valid);
+
+/**
+ * @brief Writes the optimal solution of a new game.
+ *
+ * Call it with a NULL buffer first to learn the number of moves.
+ *
+ * @param variant The rules of the game.
+ * @param disks The number of disks.
+ * @param moves Receives the moves, each a source and a destination tower.
+ * @param capacity The number of moves, not bytes, `moves` can hold.
+ * @param count Receives the number of moves of the solution.
+ * @return TOH_ERROR_BUFFER_TOO_SMALL, with `count` set, if the solution does
+ * not fit; nothing is written then.
+ */
+TOH_API toh_status toh_solve(toh_variant variant, size_t disks, uint8_t *moves,
+                             size_t capacity, size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
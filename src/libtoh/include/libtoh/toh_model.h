@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string_view>
+
+#include "libtoh/trace.h"
+
 /**
  * @namespace toh
  * @brief Contains classes and enumerations for implementing the Tower of Hanoi
@@ -7,33 +11,56 @@
  */
 namespace toh {
 
+namespace detail {
 /**
- * @brief Solves the Tower of Hanoi puzzle and records the disk moves.
+ * @brief Recursive step of solveToh.
  *
- * @tparam ChoiceType The type representing the tower (e.g., char, int, etc.).
+ * @tparam ChoiceType The type representing the tower.
+ * @tparam Selections A std::vector of ChoiceType, or any type with a
+ * `push_back(ChoiceType)` member.
  * @param selections A vector to store the source and destination of each move.
  * @param disk The number of disks to move.
  * @param src The source tower.
  * @param tmp The temporary (auxiliary) tower.
  * @param dst The destination tower.
- *
- * This function recursively solves the Tower of Hanoi puzzle, pushing each move
- * (from the source to the destination) into the selections vector. Each move is
- * represented by a pair of values indicating the source and destination towers.
  */
-template <typename ChoiceType>
-void solveToh(std::vector<ChoiceType> &selections, size_t disk, ChoiceType src,
-              ChoiceType tmp, ChoiceType dst) {
+template <typename ChoiceType, typename Selections>
+void solveTohRecursive(Selections &selections, size_t disk,
+                       ChoiceType src, ChoiceType tmp, ChoiceType dst) {
   if (disk > 0) {
     // Move n-1 disks from src to tmp using dst as auxiliary
-    solveToh(selections, disk - 1, src, dst, tmp);
+    solveTohRecursive(selections, disk - 1, src, dst, tmp);
     // Move the nth disk from src to dst
     selections.push_back(src);
     selections.push_back(dst);
     // Move the n-1 disks from tmp to dst using src as auxiliary
-    solveToh(selections, disk - 1, tmp, src, dst);
+    solveTohRecursive(selections, disk - 1, tmp, src, dst);
   }
 }
+} // namespace detail
+
+/**
+ * @brief Solves the Tower of Hanoi puzzle and records the disk moves.
+ *
+ * @tparam ChoiceType The type representing the tower (e.g., char, int, etc.).
+ * @tparam Selections A std::vector of ChoiceType, or any type with a
+ * `push_back(ChoiceType)` member.
+ * @param selections A vector to store the source and destination of each move.
+ * @param disk The number of disks to move.
+ * @param src The source tower.
+ * @param tmp The temporary (auxiliary) tower.
+ * @param dst The destination tower.
+ *
+ * This function recursively solves the Tower of Hanoi puzzle, pushing each move
+ * (from the source to the destination) into the selections vector. Each move is
+ * represented by a pair of values indicating the source and destination towers.
+ */
+template <typename ChoiceType, typename Selections>
+void solveToh(Selections &selections, size_t disk, ChoiceType src,
+              ChoiceType tmp, ChoiceType dst) {
+  TOH_TRACE_SCOPE("solveToh");
+  detail::solveTohRecursive(selections, disk, src, tmp, dst);
+}
 
 /**
  * @enum Position
@@ -46,12 +73,411 @@ enum Position : uint64_t {
   End       ///< Indicates an invalid or no selection.
 };
 
+namespace detail {
+/**
+ * @brief Moves disks one step clockwise under the cyclic rule.
+ *
+ * @tparam ChoiceType The type representing the tower.
+ * @tparam Selections A std::vector of ChoiceType, or any type with a
+ * `push_back(ChoiceType)` member.
+ * @param selections A vector to store the source and destination of each move.
+ * @param disk The number of disks to move.
+ * @param from The tower to move the disks from.
+ * @param to The tower one step clockwise from `from`.
+ * @param other The remaining tower.
+ */
+template <typename ChoiceType, typename Selections>
+void solveCyclicOneStep(Selections &selections, size_t disk,
+                        ChoiceType from, ChoiceType to, ChoiceType other);
+
+/**
+ * @brief Moves disks two steps clockwise under the cyclic rule.
+ *
+ * @tparam ChoiceType The type representing the tower.
+ * @tparam Selections A std::vector of ChoiceType, or any type with a
+ * `push_back(ChoiceType)` member.
+ * @param selections A vector to store the source and destination of each move.
+ * @param disk The number of disks to move.
+ * @param from The tower to move the disks from.
+ * @param via The tower one step clockwise from `from`.
+ * @param to The tower two steps clockwise from `from`.
+ */
+template <typename ChoiceType, typename Selections>
+void solveCyclicTwoSteps(Selections &selections, size_t disk,
+                         ChoiceType from, ChoiceType via, ChoiceType to) {
+  if (disk > 0) {
+    // Clear the n-1 disks out of the way, onto `to`
+    solveCyclicTwoSteps(selections, disk - 1, from, via, to);
+    // Move the nth disk its first step
+    selections.push_back(from);
+    selections.push_back(via);
+    // Bring the n-1 disks back one step, onto `from`
+    solveCyclicOneStep(selections, disk - 1, to, from, via);
+    // Move the nth disk its second step
+    selections.push_back(via);
+    selections.push_back(to);
+    // Move the n-1 disks on top of it
+    solveCyclicTwoSteps(selections, disk - 1, from, via, to);
+  }
+}
+
+template <typename ChoiceType, typename Selections>
+void solveCyclicOneStep(Selections &selections, size_t disk,
+                        ChoiceType from, ChoiceType to, ChoiceType other) {
+  if (disk > 0) {
+    // Move the n-1 disks two steps, out of the way onto `other`
+    solveCyclicTwoSteps(selections, disk - 1, from, to, other);
+    // Move the nth disk
+    selections.push_back(from);
+    selections.push_back(to);
+    // Move the n-1 disks two steps, on top of it
+    solveCyclicTwoSteps(selections, disk - 1, other, from, to);
+  }
+}
+
+/**
+ * @brief Moves disks between the two end towers through the middle one.
+ *
+ * @tparam ChoiceType The type representing the tower.
+ * @tparam Selections A std::vector of ChoiceType, or any type with a
+ * `push_back(ChoiceType)` member.
+ * @param selections A vector to store the source and destination of each move.
+ * @param disk The number of disks to move.
+ * @param src The end tower to move the disks from.
+ * @param mid The middle tower.
+ * @param dst The end tower to move the disks to.
+ */
+template <typename ChoiceType, typename Selections>
+void solveAdjacent(Selections &selections, size_t disk,
+                   ChoiceType src, ChoiceType mid, ChoiceType dst) {
+  if (disk > 0) {
+    // Move the n-1 disks to the far end
+    solveAdjacent(selections, disk - 1, src, mid, dst);
+    // Move the nth disk to the middle
+    selections.push_back(src);
+    selections.push_back(mid);
+    // Move the n-1 disks back to the near end
+    solveAdjacent(selections, disk - 1, dst, mid, src);
+    // Move the nth disk to the far end
+    selections.push_back(mid);
+    selections.push_back(dst);
+    // Move the n-1 disks on top of it
+    solveAdjacent(selections, disk - 1, src, mid, dst);
+  }
+}
+} // namespace detail
+
+/**
+ * @struct ClassicRule
+ * @brief The classic rules: any tower to any tower, never a larger disk on a
+ * smaller one.
+ *
+ * A rule policy is a stateless type with the following static members, all
+ * resolved at compile time by BasicGame:
+ * - `Name`, a short identifier of the variant,
+ * - `canMove(from, to)`, whether a disk may travel between two towers,
+ * - `canStack(disk, below)`, whether a disk may be placed on another disk,
+ * - `solve(selections, disk, src, tmp, dst)`, an optimal solver with the same
+ *   contract as solveToh.
+ */
+struct ClassicRule {
+  static constexpr std::string_view Name{"classic"}; ///< Variant identifier.
+
+  /**
+   * @brief Checks whether a disk may travel between two towers.
+   * @return Always true.
+   */
+  [[nodiscard]] static constexpr bool canMove(Position, Position) {
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a disk may be placed on another disk.
+   * @param disk The disk being moved.
+   * @param below The top disk of the destination tower.
+   * @return true if `disk` is smaller than `below`.
+   */
+  [[nodiscard]] static constexpr bool canStack(size_t disk, size_t below) {
+    return disk < below;
+  }
+
+  /**
+   * @brief Solves the puzzle optimally; see solveToh.
+   *
+   * @tparam ChoiceType The type representing the tower.
+   * @tparam Selections A std::vector of ChoiceType, or any type with a
+   * `push_back(ChoiceType)` member.
+   * @param selections A vector to store the source and destination of each
+   * move.
+   * @param disk The number of disks to move.
+   * @param src The source tower.
+   * @param tmp The temporary (auxiliary) tower.
+   * @param dst The destination tower.
+   */
+  template <typename ChoiceType, typename Selections>
+  static void solve(Selections &selections, size_t disk,
+                    ChoiceType src, ChoiceType tmp, ChoiceType dst) {
+    solveToh(selections, disk, src, tmp, dst);
+  }
+};
+
+/**
+ * @struct CyclicRule
+ * @brief Disks may only move clockwise: left to middle, middle to right and
+ * right to left.
+ */
+struct CyclicRule {
+  static constexpr std::string_view Name{"cyclic"}; ///< Variant identifier.
+
+  /**
+   * @brief Checks whether a disk may travel between two towers.
+   * @param from The tower the disk leaves.
+   * @param to The tower the disk lands on.
+   * @return true if `to` is one step clockwise from `from`.
+   */
+  [[nodiscard]] static constexpr bool canMove(Position from, Position to) {
+    return to == (from + 1) % 3;
+  }
+
+  /**
+   * @brief Checks whether a disk may be placed on another disk.
+   * @param disk The disk being moved.
+   * @param below The top disk of the destination tower.
+   * @return true if `disk` is smaller than `below`.
+   */
+  [[nodiscard]] static constexpr bool canStack(size_t disk, size_t below) {
+    return disk < below;
+  }
+
+  /**
+   * @brief Solves the puzzle optimally with clockwise moves only.
+   *
+   * The clockwise order is taken to be `src`, `tmp`, `dst`, so the tower
+   * travels two steps; call it with `Left, Middle, Right` for the game.
+   *
+   * @tparam ChoiceType The type representing the tower.
+   * @tparam Selections A std::vector of ChoiceType, or any type with a
+   * `push_back(ChoiceType)` member.
+   * @param selections A vector to store the source and destination of each
+   * move.
+   * @param disk The number of disks to move.
+   * @param src The source tower.
+   * @param tmp The tower one step clockwise from `src`.
+   * @param dst The destination tower.
+   */
+  template <typename ChoiceType, typename Selections>
+  static void solve(Selections &selections, size_t disk,
+                    ChoiceType src, ChoiceType tmp, ChoiceType dst) {
+    TOH_TRACE_SCOPE("CyclicRule::solve");
+    detail::solveCyclicTwoSteps(selections, disk, src, tmp, dst);
+  }
+};
+
+/**
+ * @struct AdjacentRule
+ * @brief Disks may only move between neighbouring towers; the left and right
+ * towers are not connected.
+ */
+struct AdjacentRule {
+  static constexpr std::string_view Name{"adjacent"}; ///< Variant identifier.
+
+  /**
+   * @brief Checks whether a disk may travel between two towers.
+   * @param from The tower the disk leaves.
+   * @param to The tower the disk lands on.
+   * @return true if one of the towers is the middle one.
+   */
+  [[nodiscard]] static constexpr bool canMove(Position from, Position to) {
+    return from == Middle || to == Middle;
+  }
+
+  /**
+   * @brief Checks whether a disk may be placed on another disk.
+   * @param disk The disk being moved.
+   * @param below The top disk of the destination tower.
+   * @return true if `disk` is smaller than `below`.
+   */
+  [[nodiscard]] static constexpr bool canStack(size_t disk, size_t below) {
+    return disk < below;
+  }
+
+  /**
+   * @brief Solves the puzzle optimally through the middle tower, in
+   * `3^disk - 1` moves.
+   *
+   * @tparam ChoiceType The type representing the tower.
+   * @tparam Selections A std::vector of ChoiceType, or any type with a
+   * `push_back(ChoiceType)` member.
+   * @param selections A vector to store the source and destination of each
+   * move.
+   * @param disk The number of disks to move.
+   * @param src The source tower, an end tower.
+   * @param tmp The middle tower.
+   * @param dst The destination tower, the other end tower.
+   */
+  template <typename ChoiceType, typename Selections>
+  static void solve(Selections &selections, size_t disk,
+                    ChoiceType src, ChoiceType tmp, ChoiceType dst) {
+    TOH_TRACE_SCOPE("AdjacentRule::solve");
+    detail::solveAdjacent(selections, disk, src, tmp, dst);
+  }
+};
+
+/**
+ * @struct BicolorRule
+ * @brief Disks alternate in colour by size and a disk may never be placed
+ * directly on a disk of the same colour.
+ */
+struct BicolorRule {
+  static constexpr std::string_view Name{"bicolor"}; ///< Variant identifier.
+
+  /**
+   * @brief Checks whether a disk may travel between two towers.
+   * @return Always true.
+   */
+  [[nodiscard]] static constexpr bool canMove(Position, Position) {
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a disk may be placed on another disk.
+   * @param disk The disk being moved.
+   * @param below The top disk of the destination tower.
+   * @return true if `disk` is smaller than `below` and of the other colour.
+   */
+  [[nodiscard]] static constexpr bool canStack(size_t disk, size_t below) {
+    return disk < below && disk % 2 != below % 2;
+  }
+
+  /**
+   * @brief Solves the puzzle optimally; see solveToh.
+   *
+   * The classic optimal solution never places a disk on one of the same
+   * parity, so it is also the optimal solution under this rule.
+   *
+   * @tparam ChoiceType The type representing the tower.
+   * @tparam Selections A std::vector of ChoiceType, or any type with a
+   * `push_back(ChoiceType)` member.
+   * @param selections A vector to store the source and destination of each
+   * move.
+   * @param disk The number of disks to move.
+   * @param src The source tower.
+   * @param tmp The temporary (auxiliary) tower.
+   * @param dst The destination tower.
+   */
+  template <typename ChoiceType, typename Selections>
+  static void solve(Selections &selections, size_t disk,
+                    ChoiceType src, ChoiceType tmp, ChoiceType dst) {
+    solveToh(selections, disk, src, tmp, dst);
+  }
+};
+
+/**
+ * @class GameBoard
+ * @brief Holds the towers and the selection of a game, independent of its
+ * rules.
+ *
+ * GameBoard offers the read-only view shared by every variant, so code that
+ * only displays a game does not depend on the rule policy. Games are
+ * modified through BasicGame.
+ */
+class GameBoard {
+public:
+  /**
+   * @brief Constructs a new board with a specified number of disks on the
+   * left tower.
+   * @param size The number of disks in the game.
+   */
+  explicit GameBoard(size_t size);
+
+  /**
+   * @brief Constructs a board from the tower of every disk.
+   * @param pegs The tower of each disk, from the smallest disk to the largest.
+   * None of them may be End.
+   * @param selection The selected tower; End or a tower holding a disk.
+   */
+  GameBoard(const std::vector<Position> &pegs, Position selection);
+
+  /**
+   * @brief Copy constructor for the GameBoard class.
+   * @param src The board to copy from.
+   */
+  GameBoard(const GameBoard &src) = default;
+
+  /**
+   * @brief Move constructor for the GameBoard class.
+   * @param src The board to move from.
+   */
+  GameBoard(GameBoard &&src) noexcept = default;
+
+  /**
+   * @brief Copy assignment operator.
+   * @param src The board to copy from.
+   * @return A reference to the current board.
+   */
+  GameBoard &operator=(const GameBoard &src) = default;
+
+  /**
+   * @brief Move assignment operator.
+   * @param src The board to move from.
+   * @return A reference to the current board.
+   */
+  GameBoard &operator=(GameBoard &&src) noexcept = default;
+
+  /**
+   * @brief Destructor for the GameBoard class.
+   */
+  virtual ~GameBoard() = default;
+
+  /**
+   * @brief Equality comparison operator.
+   * @param other The other board to compare.
+   * @return true if the two boards are equal, false otherwise.
+   */
+  [[nodiscard]] bool operator==(const GameBoard &other) const = default;
+
+  /**
+   * @brief Checks if the game is finished.
+   * @return true if the game is finished, false otherwise.
+   */
+  [[nodiscard]] bool isFinished() const;
+
+  /**
+   * @brief Gets the disks from a tower at the specified position.
+   * @param position The position of the tower.
+   * @return A constant reference to the vector of disk sizes for the selected
+   * tower.
+   */
+  const std::vector<size_t> &getTower(Position position) const;
+
+  /**
+   * @brief Checks if the specified tower is currently selected.
+   * @param position The position of the tower to check.
+   * @return true if the given tower is selected, false otherwise.
+   *
+   * This method verifies whether the tower at the specified position is the one
+   * currently selected.
+   */
+  [[nodiscard]] bool isSelected(Position position) const;
+
+protected:
+  std::vector<std::vector<size_t>> m_towers{
+      {}, {}, {}};                     ///< The towers in the game.
+  Position m_selection{Position::End}; ///< The currently selected tower.
+};
+
 /**
- * @class Game
+ * @class BasicGame
  * @brief Manages the state and operations of the Tower of Hanoi game.
  *
- * The Game class allows selecting towers, moving disks, and checking if the
- * game is complete. It handles the gameplay logic of the Tower of Hanoi.
+ * @tparam Rule The rule policy, e.g. ClassicRule, CyclicRule, AdjacentRule or
+ * BicolorRule.
+ *
+ * The BasicGame class allows selecting towers, moving disks, and checking if
+ * the game is complete. It handles the gameplay logic of the Tower of Hanoi.
+ * The rule policy is resolved at compile time, so checking a move costs no
+ * virtual call or runtime branch on the variant; Game, the classic game,
+ * compiles to the same code as a game with the rules written out by hand.
  *
  * ### Example
  * ```cpp
@@ -71,51 +497,61 @@ enum Position : uint64_t {
  * }
  * ```
  */
-class Game {
+template <typename Rule> class BasicGame : public GameBoard {
 public:
+  using RuleType = Rule; ///< The rule policy of the game.
+
   /**
    * @brief Constructs a new Game with a specified number of disks.
    * @param size The number of disks in the game.
    */
-  explicit Game(size_t size);
+  explicit BasicGame(size_t size);
+
+  /**
+   * @brief Constructs a game from the tower of every disk.
+   * @param pegs The tower of each disk, from the smallest disk to the largest.
+   * None of them may be End.
+   * @param selection The selected tower; End or a tower holding a disk.
+   */
+  BasicGame(const std::vector<Position> &pegs, Position selection);
 
   /**
-   * @brief Copy constructor for the Game class.
+   * @brief Copy constructor for the BasicGame class.
    * @param src The game instance to copy from.
    */
-  Game(const Game &src) = default;
+  BasicGame(const BasicGame &src) = default;
 
   /**
-   * @brief Move constructor for the Game class.
+   * @brief Move constructor for the BasicGame class.
    * @param src The game instance to move from.
    */
-  Game(Game &&src) noexcept = default;
+  BasicGame(BasicGame &&src) noexcept = default;
 
   /**
    * @brief Copy assignment operator.
    * @param src The game instance to copy from.
    * @return A reference to the current game instance.
    */
-  Game &operator=(const Game &src) = default;
+  BasicGame &operator=(const BasicGame &src) = default;
 
   /**
    * @brief Move assignment operator.
    * @param src The game instance to move from.
    * @return A reference to the current game instance.
    */
-  Game &operator=(Game &&src) noexcept = default;
+  BasicGame &operator=(BasicGame &&src) noexcept = default;
 
   /**
-   * @brief Destructor for the Game class.
+   * @brief Destructor for the BasicGame class.
    */
-  virtual ~Game() = default;
+  ~BasicGame() override = default;
 
   /**
    * @brief Equality comparison operator.
    * @param other The other game instance to compare.
    * @return true if the two game instances are equal, false otherwise.
    */
-  [[nodiscard]] bool operator==(const Game &other) const = default;
+  [[nodiscard]] bool operator==(const BasicGame &other) const = default;
 
   /**
    * @brief Selects a tower by its position.
@@ -128,30 +564,6 @@ public:
    */
   void select(Position position);
 
-  /**
-   * @brief Checks if the game is finished.
-   * @return true if the game is finished, false otherwise.
-   */
-  [[nodiscard]] bool isFinished() const;
-
-  /**
-   * @brief Gets the disks from a tower at the specified position.
-   * @param position The position of the tower.
-   * @return A constant reference to the vector of disk sizes for the selected
-   * tower.
-   */
-  const std::vector<size_t> &getTower(Position position) const;
-
-  /**
-   * @brief Checks if the specified tower is currently selected.
-   * @param position The position of the tower to check.
-   * @return true if the given tower is selected, false otherwise.
-   *
-   * This method verifies whether the tower at the specified position is the one
-   * currently selected.
-   */
-  [[nodiscard]] bool isSelected(Position position) const;
-
 private:
   /**
    * @brief Moves a disk from one tower to another.
@@ -160,15 +572,20 @@ private:
    * @return true if the move is successful, false otherwise.
    *
    * This method moves a disk from the 'from' tower to the 'to' tower, following
-   * the Tower of Hanoi rules (a larger disk cannot be placed on top of a
-   * smaller disk).
+   * the rule policy (for the classic rules, a larger disk cannot be placed on
+   * top of a smaller disk).
    */
   bool move(Position from, Position to);
-
-private:
-  std::vector<std::vector<size_t>> m_towers{
-      {}, {}, {}};                     ///< The towers in the game.
-  Position m_selection{Position::End}; ///< The currently selected tower.
 };
 
+extern template class BasicGame<ClassicRule>;
+extern template class BasicGame<CyclicRule>;
+extern template class BasicGame<AdjacentRule>;
+extern template class BasicGame<BicolorRule>;
+
+using Game = BasicGame<ClassicRule>;          ///< The classic game.
+using CyclicGame = BasicGame<CyclicRule>;     ///< Clockwise moves only.
+using AdjacentGame = BasicGame<AdjacentRule>; ///< Neighbouring towers only.
+using BicolorGame = BasicGame<BicolorRule>;   ///< No same-colour stacking.
+
 } // namespace toh
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @namespace toh::trace
+ * @brief A lightweight, per-thread tracing facility emitting Chrome
+ * trace-event JSON.
+ *
+ * Trace zones are declared with `TOH_TRACE_SCOPE(name)`. When the project is
+ * configured with `-DTOH_TRACING=ON` every zone records a complete event into
+ * a buffer owned by the calling thread; recording takes no lock. Otherwise
+ * the macro expands to nothing and zones cost nothing.
+ *
+ * The collected events can be written with writeChromeTrace() and opened in
+ * Perfetto or `chrome://tracing`.
+ *
+ * ### Example
+ * ```cpp
+ * #include <fstream>
+ *
+ * #include "libtoh/toh_model.h"
+ * #include "libtoh/trace.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   vector<Position> plays{};
+ *   solveToh(plays, 10, Left, Middle, Right);
+ *
+ *   ofstream file{"toh.trace.json"};
+ *   trace::writeChromeTrace(file);
+ * }
+ * ```
+ */
+namespace toh::trace {
+
+/**
+ * @brief Checks whether tracing was compiled in.
+ * @return true if trace zones record events, false otherwise.
+ */
+[[nodiscard]] constexpr bool isEnabled() {
+#ifdef TOH_ENABLE_TRACING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Writes all events recorded so far as Chrome trace-event JSON.
+ * @param out The stream to write to.
+ *
+ * Events of every thread that recorded at least one zone are included, even
+ * if the thread has exited. When tracing is compiled out an empty, valid
+ * trace is written.
+ */
+void writeChromeTrace(std::ostream &out);
+
+#ifdef TOH_ENABLE_TRACING
+/**
+ * @class Zone
+ * @brief Records a complete trace event spanning its own lifetime.
+ *
+ * Use the `TOH_TRACE_SCOPE` macro instead of constructing zones directly, so
+ * they disappear when tracing is compiled out.
+ */
+class Zone {
+public:
+  /**
+   * @brief Starts a zone.
+   * @param name The name of the event; must outlive the trace.
+   */
+  explicit Zone(const char *name) noexcept;
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source Zone object (unused).
+   */
+  Zone(const Zone &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source Zone object (unused).
+   * @return Deleted.
+   */
+  Zone &operator=(const Zone &src) = delete;
+
+  /**
+   * @brief Ends the zone and records the event.
+   */
+  ~Zone();
+
+private:
+  const char *m_name; ///< The name of the event.
+  int64_t m_start;    ///< The start time in nanoseconds since trace start.
+};
+
+#define TOH_TRACE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define TOH_TRACE_CONCAT(lhs, rhs) TOH_TRACE_CONCAT_IMPL(lhs, rhs)
+#define TOH_TRACE_SCOPE(name)                                                  \
+  const ::toh::trace::Zone TOH_TRACE_CONCAT(toh_trace_zone_, __LINE__) { name }
+#else
+#define TOH_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+} // namespace toh::trace
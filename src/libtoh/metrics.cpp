@@ -0,0 +1,91 @@
+#include "libtoh/metrics.h"
+
+#include <filesystem>
+#include <fstream>
+
+#ifdef TOH_ENABLE_METRICS
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#endif
+
+using namespace std;
+using namespace toh::metrics;
+
+#ifdef TOH_ENABLE_METRICS
+namespace {
+struct Description {
+  string_view name;
+  string_view type;
+  string_view help;
+};
+
+constexpr array<Description, MetricCount> Descriptions{{
+    {"toh_selects_total", "counter", "Towers selected."},
+    {"toh_moves_total", "counter", "Disks moved."},
+    {"toh_rejected_moves_total", "counter", "Moves refused by the rules."},
+    {"toh_frames_rendered_total", "counter", "Frames rendered."},
+    {"toh_events_handled_total", "counter", "Events given to a controller."},
+    {"toh_active_sessions", "gauge", "Games being played."},
+}};
+
+/*
+ * Slots are kept after their thread exits, so counters never go back. A
+ * thread that exits inside a scoped gauge is not expected.
+ */
+struct Registry {
+  mutex lock{};
+  vector<unique_ptr<detail::Slot>> slots{};
+};
+
+Registry &registry() {
+  static Registry instance{};
+  return instance;
+}
+} // namespace
+
+detail::Slot *toh::metrics::detail::registerSlot() {
+  auto &instance{registry()};
+  lock_guard guard{instance.lock};
+  return instance.slots.emplace_back(make_unique<Slot>()).get();
+}
+
+int64_t toh::metrics::value(Metric metric) {
+  auto &instance{registry()};
+  lock_guard guard{instance.lock};
+  int64_t sum{0};
+  for (auto &&slot : instance.slots)
+    sum += slot->values[static_cast<size_t>(metric)].load(memory_order_relaxed);
+  return sum;
+}
+
+void toh::metrics::writePrometheus(ostream &out) {
+  for (size_t i{0}; i < MetricCount; i += 1) {
+    auto &description{Descriptions[i]};
+    out << "# HELP " << description.name << ' ' << description.help << '\n'
+        << "# TYPE " << description.name << ' ' << description.type << '\n'
+        << description.name << ' ' << value(static_cast<Metric>(i)) << '\n';
+  }
+}
+#else
+int64_t toh::metrics::value(Metric) { return 0; }
+
+void toh::metrics::writePrometheus(ostream &) {}
+#endif
+
+bool toh::metrics::writePrometheusFile(const string &path) {
+  auto temporary{path + ".tmp"};
+  ofstream file{temporary, ios::trunc};
+  writePrometheus(file);
+  file.close();
+  // Unlike std::rename, this replaces the previous scrape on Windows too.
+  error_code error{};
+  if (file)
+    filesystem::rename(temporary, path, error);
+  if (!file || error) {
+    filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,288 @@
+#include "libtoh/move_log.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace std;
+using namespace toh;
+
+namespace {
+constexpr array<uint8_t, 4> Magic{'T', 'O', 'H', 'L'};
+constexpr uint8_t ForwardTag{0};
+constexpr uint8_t BackwardTag{1};
+constexpr uint8_t MoveTag{2};
+constexpr uint8_t SeekTag{3};
+// Keeps `count << 2` within 64 bits; longer runs are split.
+constexpr uint64_t MaxRun{uint64_t{1} << 61};
+// Keeps `distance << 3` within 64 bits; longer seeks are split.
+constexpr uint64_t MaxSeek{uint64_t{1} << 60};
+
+void putVarint(vector<uint8_t> &bytes, uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+// Reads a varint at `offset` and moves the offset past it.
+optional<uint64_t> getVarint(span<const uint8_t> bytes, size_t &offset) {
+  uint64_t value{0};
+  for (size_t shift{0}; offset < bytes.size() && shift < 64; shift += 7) {
+    auto byte{bytes[offset++]};
+    value |= uint64_t{byte & 0x7Fu} << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  return nullopt;
+}
+} // namespace
+
+MoveLogWriter::MoveLogWriter(size_t disks)
+    : m_disks{disks}, m_bytes{begin(Magic), end(Magic)} {
+  if (disks > MaxPathDisks)
+    throw invalid_argument{"too many disks for a move log"};
+  m_bytes.push_back(MoveLogVersion);
+  putVarint(m_bytes, disks);
+}
+
+void MoveLogWriter::append(Move move) {
+  if (move.from >= End || move.to >= End)
+    throw invalid_argument{"a move needs two towers"};
+
+  if (!m_game) {
+    if (m_index < optimalLength(m_disks) &&
+        move == optimalMove(m_disks, m_index)) {
+      if (m_backwards || m_run == MaxRun)
+        flush();
+      m_backwards = false;
+      m_run += 1;
+      m_index += 1;
+      return;
+    }
+    if (m_index > 0 && move == optimalMove(m_disks, m_index - 1).reversed()) {
+      if (!m_backwards || m_run == MaxRun)
+        flush();
+      m_backwards = true;
+      m_run += 1;
+      m_index -= 1;
+      return;
+    }
+    flush();
+    m_game.emplace(optimalState(m_disks, m_index), End);
+  }
+
+  writeToken(move.from * 3 + move.to, MoveTag);
+  m_game->select(move.from);
+  m_game->select(move.to);
+  m_game->select(End);
+  // A detour may rejoin the path anywhere, not only where it left it.
+  if (auto index{optimalIndex(*m_game)}) {
+    seek(*index);
+    m_game.reset();
+  }
+}
+
+vector<uint8_t> MoveLogWriter::finish() {
+  flush();
+  return std::move(m_bytes);
+}
+
+void MoveLogWriter::flush() {
+  if (m_run > 0)
+    writeToken(m_run, m_backwards ? BackwardTag : ForwardTag);
+  m_run = 0;
+}
+
+void MoveLogWriter::seek(uint64_t index) {
+  auto backwards{index < m_index};
+  auto distance{backwards ? m_index - index : index - m_index};
+  while (distance > 0) {
+    auto step{min(distance, MaxSeek)};
+    writeToken(step << 1 | (backwards ? 1 : 0), SeekTag);
+    distance -= step;
+  }
+  m_index = index;
+}
+
+void MoveLogWriter::writeToken(uint64_t value, uint8_t tag) {
+  putVarint(m_bytes, value << 2 | tag);
+}
+
+MoveLogReader::MoveLogReader(span<const uint8_t> bytes) : m_bytes{bytes} {
+  if (bytes.size() <= Magic.size() ||
+      !equal(begin(Magic), end(Magic), begin(bytes)) ||
+      bytes[Magic.size()] != MoveLogVersion)
+    return;
+  size_t offset{Magic.size() + 1};
+  auto disks{getVarint(bytes, offset)};
+  if (!disks || *disks > MaxPathDisks)
+    return;
+  m_valid = true;
+  m_disks = static_cast<size_t>(*disks);
+  m_start = offset;
+  m_token = {offset, offset};
+}
+
+bool MoveLogReader::atEnd() const {
+  return m_valid && m_offset == m_token.count &&
+         m_token.end == m_bytes.size();
+}
+
+optional<Move> MoveLogReader::next() {
+  if (!enterToken())
+    return nullopt;
+
+  Move move{m_token.move};
+  if (m_token.tag == ForwardTag) {
+    if (m_index >= optimalLength(m_disks))
+      return nullopt;
+    move = optimalMove(m_disks, m_index);
+    m_index += 1;
+  } else if (m_token.tag == BackwardTag) {
+    if (m_index == 0)
+      return nullopt;
+    m_index -= 1;
+    move = optimalMove(m_disks, m_index).reversed();
+  }
+  m_offset += 1;
+  m_position += 1;
+  return move;
+}
+
+size_t MoveLogReader::read(span<Move> moves) {
+  size_t done{0};
+  while (done < moves.size() && enterToken()) {
+    auto count{min(m_token.count - m_offset, uint64_t{moves.size() - done})};
+    auto out{moves.subspan(done, static_cast<size_t>(count))};
+    if (m_token.tag == ForwardTag) {
+      if (count > optimalLength(m_disks) - m_index)
+        break;
+      for (size_t i{0}; i < out.size(); i += 1)
+        out[i] = optimalMove(m_disks, m_index + i);
+      m_index += count;
+    } else if (m_token.tag == BackwardTag) {
+      if (count > m_index)
+        break;
+      for (size_t i{0}; i < out.size(); i += 1)
+        out[i] = optimalMove(m_disks, m_index - 1 - i).reversed();
+      m_index -= count;
+    } else {
+      fill(begin(out), end(out), m_token.move);
+    }
+    m_offset += count;
+    m_position += count;
+    done += out.size();
+  }
+  return done;
+}
+
+optional<Move> MoveLogReader::previous() {
+  if (!m_valid)
+    return nullopt;
+  while (m_offset == 0) {
+    auto token{decodeBefore(m_token.begin)};
+    if (!token || !crossSeek(m_token, false))
+      return nullopt;
+    m_token = *token;
+    m_offset = m_token.count;
+  }
+
+  Move move{m_token.move};
+  if (m_token.tag == ForwardTag) {
+    if (m_index == 0)
+      return nullopt;
+    m_index -= 1;
+    move = optimalMove(m_disks, m_index);
+  } else if (m_token.tag == BackwardTag) {
+    if (m_index >= optimalLength(m_disks))
+      return nullopt;
+    move = optimalMove(m_disks, m_index).reversed();
+    m_index += 1;
+  }
+  m_offset -= 1;
+  m_position -= 1;
+  return move;
+}
+
+bool MoveLogReader::enterToken() {
+  if (!m_valid)
+    return false;
+  while (m_offset == m_token.count) {
+    auto token{decodeAt(m_token.end)};
+    if (!token || !crossSeek(*token, true))
+      return false;
+    m_token = *token;
+    m_offset = 0;
+  }
+  return true;
+}
+
+bool MoveLogReader::crossSeek(const Token &token, bool forwards) {
+  if (token.tag != SeekTag)
+    return true;
+  if (token.backwards == forwards) {
+    if (token.distance > m_index)
+      return false;
+    m_index -= token.distance;
+  } else {
+    if (token.distance > optimalLength(m_disks) - m_index)
+      return false;
+    m_index += token.distance;
+  }
+  return true;
+}
+
+optional<MoveLogReader::Token> MoveLogReader::decodeAt(size_t begin) const {
+  auto end{begin};
+  auto value{getVarint(m_bytes, end)};
+  if (!value)
+    return nullopt;
+
+  Token token{begin, end, static_cast<uint8_t>(*value & 3), *value >> 2};
+  if (token.tag == MoveTag) {
+    if (token.count >= 9)
+      return nullopt;
+    token.move = {static_cast<Position>(token.count / 3),
+                  static_cast<Position>(token.count % 3)};
+    token.count = 1;
+  } else if (token.tag == SeekTag) {
+    token.distance = token.count >> 1;
+    token.backwards = (token.count & 1) != 0;
+    token.count = 0;
+  }
+  return token;
+}
+
+optional<MoveLogReader::Token> MoveLogReader::decodeBefore(size_t end) const {
+  if (end <= m_start || (m_bytes[end - 1] & 0x80) != 0)
+    return nullopt;
+  auto begin{end - 1};
+  while (begin > m_start && (m_bytes[begin - 1] & 0x80) != 0)
+    begin -= 1;
+  auto token{decodeAt(begin)};
+  if (!token || token->end != end)
+    return nullopt;
+  return token;
+}
+
+vector<uint8_t> toh::encodeMoveLog(size_t disks, span<const Move> moves) {
+  MoveLogWriter writer{disks};
+  for (auto &&move : moves)
+    writer.append(move);
+  return writer.finish();
+}
+
+optional<vector<Move>> toh::decodeMoveLog(span<const uint8_t> bytes) {
+  MoveLogReader reader{bytes};
+  vector<Move> moves{};
+  size_t read{0};
+  do {
+    moves.resize(max(2 * read, size_t{4096}));
+    read += reader.read(span{moves}.subspan(read));
+  } while (read == moves.size());
+  moves.resize(read);
+  if (!reader.atEnd())
+    return nullopt;
+  return moves;
+}
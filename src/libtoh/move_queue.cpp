@@ -0,0 +1,106 @@
+#include "libtoh/move_queue.h"
+
+#include <bit>
+#include <stdexcept>
+
+using namespace std;
+using namespace toh;
+
+template <typename GameType>
+optional<uint64_t> BasicMoveQueue<GameType>::Producer::submit(Move move) {
+  if (pending() >= m_queue->m_capacity ||
+      !m_queue->push(m_index, m_submitted, move))
+    return nullopt;
+  return m_submitted++;
+}
+
+template <typename GameType>
+optional<MoveResult> BasicMoveQueue<GameType>::Producer::poll() {
+  if (m_published.load(memory_order_acquire) == m_polled)
+    return nullopt;
+  auto result{m_results[m_polled & (m_queue->m_capacity - 1)]};
+  m_polled += 1;
+  return result;
+}
+
+template <typename GameType>
+BasicMoveQueue<GameType>::BasicMoveQueue(GameType game, size_t producers,
+                                         size_t capacity)
+    : m_game{std::move(game)}, m_producerCount{producers},
+      m_capacity{bit_ceil(capacity)} {
+  if (producers == 0 || capacity == 0)
+    throw invalid_argument{"a move queue needs producers and capacity"};
+  m_game.select(End);
+  m_cells = make_unique<Cell[]>(m_capacity);
+  for (size_t i{0}; i < m_capacity; i += 1)
+    m_cells[i].turn.store(i, memory_order_relaxed);
+  m_players = make_unique<Producer[]>(producers);
+  for (size_t i{0}; i < producers; i += 1) {
+    m_players[i].m_queue = this;
+    m_players[i].m_index = i;
+    m_players[i].m_results = make_unique<MoveResult[]>(m_capacity);
+  }
+}
+
+template <typename GameType>
+typename BasicMoveQueue<GameType>::Producer &
+BasicMoveQueue<GameType>::producer(size_t index) {
+  if (index >= m_producerCount)
+    throw out_of_range{"no such producer"};
+  return m_players[index];
+}
+
+template <typename GameType>
+size_t BasicMoveQueue<GameType>::drain(size_t limit) {
+  size_t drained{0};
+  for (; drained < limit; drained += 1) {
+    auto &cell{m_cells[m_head & (m_capacity - 1)]};
+    if (cell.turn.load(memory_order_acquire) != m_head + 1)
+      break;
+    auto move{cell.move};
+    auto &player{m_players[cell.producer]};
+    auto sequence{cell.sequence};
+    // Frees the cell for the producer that wraps around to it.
+    cell.turn.store(m_head + m_capacity, memory_order_release);
+    m_head += 1;
+
+    // The producer polls before it submits past its capacity, so the slot
+    // of this result is free.
+    auto published{player.m_published.load(memory_order_relaxed)};
+    player.m_results[published & (m_capacity - 1)] =
+        MoveResult{sequence, move, m_order, playMove(m_game, move)};
+    player.m_published.store(published + 1, memory_order_release);
+    m_order += 1;
+  }
+  return drained;
+}
+
+template <typename GameType>
+bool BasicMoveQueue<GameType>::push(size_t producer, uint64_t sequence,
+                                    Move move) {
+  auto position{m_tail.load(memory_order_relaxed)};
+  while (true) {
+    auto &cell{m_cells[position & (m_capacity - 1)]};
+    auto turn{cell.turn.load(memory_order_acquire)};
+    if (turn == position) {
+      if (m_tail.compare_exchange_weak(position, position + 1,
+                                       memory_order_relaxed)) {
+        cell.move = move;
+        cell.producer = producer;
+        cell.sequence = sequence;
+        cell.turn.store(position + 1, memory_order_release);
+        return true;
+      }
+    } else if (turn < position) {
+      // The applier has not freed the cell since the last lap: full.
+      return false;
+    } else {
+      position = m_tail.load(memory_order_relaxed);
+    }
+  }
+}
+
+template class toh::BasicMoveQueue<Game>;
+template class toh::BasicMoveQueue<CyclicGame>;
+template class toh::BasicMoveQueue<AdjacentGame>;
+template class toh::BasicMoveQueue<BicolorGame>;
@@ -0,0 +1,63 @@
+#include "libtoh/optimal_path.h"
+
+#include <utility>
+
+using namespace std;
+using namespace toh;
+
+vector<Position> toh::optimalState(size_t disks, uint64_t index) {
+  vector<Position> pegs(disks);
+  for (size_t disk{1}; disk <= disks; disk += 1) {
+    // Disk d moves every 2^d moves, first at move 2^(d-1), and always in the
+    // same direction around the towers: backwards for every other disk.
+    auto halves{index >> (disk - 1)};
+    auto moves{halves / 2 + halves % 2};
+    auto step{(disks - disk) % 2 == 0 ? uint64_t{2} : uint64_t{1}};
+    pegs[disk - 1] = static_cast<Position>(moves % 3 * step % 3);
+  }
+  return pegs;
+}
+
+optional<uint64_t> toh::optimalIndex(const vector<Position> &pegs) {
+  if (pegs.size() > MaxPathDisks)
+    return nullopt;
+  uint64_t index{0};
+  Position from{Left};
+  Position spare{Middle};
+  Position to{Right};
+  for (auto disk{pegs.size()}; disk > 0; disk -= 1) {
+    auto peg{pegs[disk - 1]};
+    if (peg == from) {
+      // The smaller disks are still on their way to the spare tower.
+      swap(spare, to);
+    } else if (peg == to) {
+      // The smaller disks have moved once and are on their way back.
+      index += uint64_t{1} << (disk - 1);
+      swap(from, spare);
+    } else {
+      return nullopt;
+    }
+  }
+  return index;
+}
+
+optional<uint64_t> toh::optimalIndex(const GameBoard &board) {
+  size_t disks{0};
+  for (auto tower : {Left, Middle, Right})
+    disks += board.getTower(tower).size();
+  if (disks > MaxPathDisks)
+    return nullopt;
+
+  vector<Position> pegs(disks, End);
+  for (auto tower : {Left, Middle, Right}) {
+    const auto &stack{board.getTower(tower)};
+    for (size_t i{0}; i < stack.size(); i += 1) {
+      auto disk{stack[i]};
+      if (disk == 0 || disk > disks || pegs[disk - 1] != End ||
+          (i > 0 && stack[i - 1] < disk))
+        return nullopt;
+      pegs[disk - 1] = tower;
+    }
+  }
+  return optimalIndex(pegs);
+}
@@ -0,0 +1,243 @@
+#include "libtoh/puzzle.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace std;
+using namespace toh;
+
+namespace {
+constexpr array<uint8_t, 4> Magic{'T', 'O', 'H', 'Z'};
+constexpr uint8_t SolvedCode{15};
+// Records encoded per write of a generating thread.
+constexpr size_t PuzzleBatch{4096};
+constexpr uint64_t Gamma{0x9E3779B97F4A7C15};
+
+// The finalizer of SplitMix64.
+uint64_t mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+  return value ^ (value >> 31);
+}
+
+// Labels walk the disks five at a time: one digit in base 243.
+constexpr size_t ChunkDisks{5};
+constexpr size_t ChunkStates{243};
+
+// What walking five disks from a target does to the walk of labelPuzzle().
+struct ChunkStep {
+  uint8_t target; ///< The target of the disk below the chunk.
+  uint8_t moved;  ///< Bit `i` is set if disk `i` of the chunk must move.
+  uint8_t from;   ///< The tower of the smallest disk that must move.
+  uint8_t to;     ///< Its target.
+};
+
+// The walk of every chunk of disks from every target, in one lookup.
+constexpr auto ChunkSteps{[] {
+  array<array<ChunkStep, ChunkStates>, 3> steps{};
+  for (uint8_t start{0}; start < 3; start += 1) {
+    for (size_t chunk{0}; chunk < ChunkStates; chunk += 1) {
+      array<uint8_t, ChunkDisks> pegs{};
+      auto digits{chunk};
+      for (auto &&peg : pegs) {
+        peg = static_cast<uint8_t>(digits % 3);
+        digits /= 3;
+      }
+      ChunkStep step{start, 0, 0, 0};
+      for (auto disk{ChunkDisks}; disk > 0; disk -= 1) {
+        auto peg{pegs[disk - 1]};
+        if (peg == step.target)
+          continue;
+        step.moved = static_cast<uint8_t>(step.moved | 1u << (disk - 1));
+        step.from = peg;
+        step.to = step.target;
+        step.target = static_cast<uint8_t>(3 - peg - step.target);
+      }
+      steps[start][chunk] = step;
+    }
+  }
+  return steps;
+}()};
+
+void putLittleEndian(uint8_t *bytes, uint64_t value) {
+  for (size_t i{0}; i < 8; i += 1)
+    bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t getLittleEndian(const uint8_t *bytes) {
+  uint64_t value{0};
+  for (size_t i{0}; i < 8; i += 1)
+    value |= uint64_t{bytes[i]} << (8 * i);
+  return value;
+}
+
+// The first record of a worker; the first `count % threads` workers write
+// one more record than the others.
+uint64_t rangeStart(uint64_t count, size_t threads, size_t worker) {
+  return worker * (count / threads) + min<uint64_t>(worker, count % threads);
+}
+
+bool writeRange(const string &path, size_t disks, uint64_t seed,
+                uint64_t first, uint64_t last) {
+  fstream file{path, ios::binary | ios::in | ios::out};
+  file.seekp(static_cast<streamoff>(PuzzleHeaderSize +
+                                    first * PuzzleRecordSize));
+  vector<uint8_t> bytes(PuzzleBatch * PuzzleRecordSize);
+  for (auto index{first}; index < last && file;) {
+    auto batch{min<uint64_t>(PuzzleBatch, last - index)};
+    for (size_t i{0}; i < batch; i += 1, index += 1) {
+      auto puzzle{labelPuzzle(disks, samplePuzzle(disks, seed, index))};
+      auto code{puzzle.next.from == End
+                    ? uint64_t{SolvedCode}
+                    : puzzle.next.from * 3 + puzzle.next.to};
+      auto record{bytes.data() + i * PuzzleRecordSize};
+      putLittleEndian(record, puzzle.rank);
+      putLittleEndian(record + 8, puzzle.distance << 4 | code);
+    }
+    file.write(reinterpret_cast<const char *>(bytes.data()),
+               static_cast<streamsize>(batch * PuzzleRecordSize));
+  }
+  return static_cast<bool>(file);
+}
+
+optional<Puzzle> decodePuzzle(size_t disks, const uint8_t *record) {
+  auto rank{getLittleEndian(record)};
+  auto label{getLittleEndian(record + 8)};
+  auto code{label & 0xF};
+  if (rank >= puzzleCount(disks) || (code >= 9 && code != SolvedCode))
+    return nullopt;
+  Puzzle puzzle{rank, label >> 4, {}};
+  if (code != SolvedCode)
+    puzzle.next = {static_cast<Position>(code / 3),
+                   static_cast<Position>(code % 3)};
+  return puzzle;
+}
+} // namespace
+
+vector<Position> toh::unrankPuzzle(size_t disks, uint64_t rank) {
+  vector<Position> pegs(disks);
+  for (auto &&peg : pegs) {
+    peg = static_cast<Position>(rank % 3);
+    rank /= 3;
+  }
+  return pegs;
+}
+
+Puzzle toh::labelPuzzle(size_t disks, uint64_t rank) {
+  // Disks past the last up to a whole chunk are placed on Right, where they
+  // never move; the chunks are then walked from the largest disks down.
+  auto chunks{(disks + ChunkDisks - 1) / ChunkDisks};
+  auto padded{rank + puzzleCount(chunks * ChunkDisks) - puzzleCount(disks)};
+  array<uint8_t, MaxPuzzleDisks / ChunkDisks> digits{};
+  for (size_t i{0}; i < chunks; i += 1) {
+    digits[i] = static_cast<uint8_t>(padded % ChunkStates);
+    padded /= ChunkStates;
+  }
+
+  Puzzle puzzle{rank, 0, {}};
+  uint8_t target{Right};
+  for (auto chunk{chunks}; chunk > 0; chunk -= 1) {
+    const auto &step{ChunkSteps[target][digits[chunk - 1]]};
+    puzzle.distance |= uint64_t{step.moved} << ((chunk - 1) * ChunkDisks);
+    if (step.moved != 0)
+      puzzle.next = {static_cast<Position>(step.from),
+                     static_cast<Position>(step.to)};
+    target = step.target;
+  }
+  return puzzle;
+}
+
+uint64_t toh::samplePuzzle(size_t disks, uint64_t seed, uint64_t index) {
+  auto count{puzzleCount(disks)};
+  // Taking values from `threshold` on leaves a multiple of `count` of them,
+  // so that every rank is equally likely.
+  auto threshold{(~count + 1) % count};
+  auto state{mix(seed ^ mix(index))};
+  while (true) {
+    state += Gamma;
+    auto value{mix(state)};
+    if (value >= threshold)
+      return value % count;
+  }
+}
+
+bool toh::writePuzzleFile(const string &path, size_t disks, uint64_t count,
+                          uint64_t seed, size_t threads) {
+  if (disks > MaxPuzzleDisks || threads == 0 ||
+      count > (~uint64_t{0} - PuzzleHeaderSize) / PuzzleRecordSize)
+    return false;
+  auto temporary{path + ".tmp"};
+  ofstream file{temporary, ios::binary | ios::trunc};
+  array<uint8_t, PuzzleHeaderSize> header{
+      Magic[0], Magic[1], Magic[2], Magic[3], PuzzleFileVersion,
+      static_cast<uint8_t>(disks)};
+  putLittleEndian(header.data() + 8, count);
+  file.write(reinterpret_cast<const char *>(header.data()),
+             static_cast<streamsize>(header.size()));
+  file.close();
+  error_code error{};
+  if (file)
+    filesystem::resize_file(temporary,
+                            PuzzleHeaderSize + count * PuzzleRecordSize, error);
+
+  atomic<bool> written{file && !error};
+  if (written) {
+    vector<jthread> workers{};
+    for (size_t worker{0}; worker < threads; worker += 1)
+      workers.emplace_back([&, worker] {
+        if (!writeRange(temporary, disks, seed,
+                        rangeStart(count, threads, worker),
+                        rangeStart(count, threads, worker + 1)))
+          written = false;
+      });
+  }
+  // Unlike std::rename, this replaces an earlier corpus on Windows too.
+  if (written)
+    filesystem::rename(temporary, path, error);
+  if (!written || error) {
+    filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+optional<PuzzleCorpus> toh::readPuzzleFile(const string &path) {
+  ifstream file{path, ios::binary};
+  array<uint8_t, PuzzleHeaderSize> header{};
+  file.read(reinterpret_cast<char *>(header.data()),
+            static_cast<streamsize>(header.size()));
+  if (!file || !equal(begin(Magic), end(Magic), begin(header)) ||
+      header[4] != PuzzleFileVersion || header[5] > MaxPuzzleDisks)
+    return nullopt;
+  PuzzleCorpus corpus{header[5], {}};
+  auto count{getLittleEndian(header.data() + 8)};
+
+  // Checking the size first keeps a corrupt count from allocating.
+  error_code error{};
+  auto size{filesystem::file_size(path, error)};
+  if (error || (size - PuzzleHeaderSize) / PuzzleRecordSize != count ||
+      (size - PuzzleHeaderSize) % PuzzleRecordSize != 0)
+    return nullopt;
+  corpus.puzzles.reserve(count);
+
+  vector<uint8_t> bytes(PuzzleBatch * PuzzleRecordSize);
+  while (corpus.puzzles.size() < count) {
+    auto batch{min<uint64_t>(PuzzleBatch, count - corpus.puzzles.size())};
+    file.read(reinterpret_cast<char *>(bytes.data()),
+              static_cast<streamsize>(batch * PuzzleRecordSize));
+    if (!file)
+      return nullopt;
+    for (size_t i{0}; i < batch; i += 1) {
+      auto puzzle{
+          decodePuzzle(corpus.disks, bytes.data() + i * PuzzleRecordSize)};
+      if (!puzzle)
+        return nullopt;
+      corpus.puzzles.push_back(*puzzle);
+    }
+  }
+  return corpus;
+}
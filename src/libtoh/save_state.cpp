@@ -0,0 +1,152 @@
+#include "libtoh/save_state.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr array<uint8_t, 4> Magic{'T', 'O', 'H', 'S'};
+constexpr size_t HeaderSize{16};
+constexpr size_t ChecksumSize{4};
+constexpr size_t MaxSnapshotSize{HeaderSize + (MaxSaveStateDisks + 3) / 4 +
+                                 ChecksumSize};
+constexpr array<string_view, 4> Rules{ClassicRule::Name, CyclicRule::Name,
+                                      AdjacentRule::Name, BicolorRule::Name};
+
+constexpr auto CrcTable{[] {
+  array<uint32_t, 256> table{};
+  for (uint32_t i{0}; i < table.size(); i += 1) {
+    auto crc{i};
+    for (size_t bit{0}; bit < 8; bit += 1)
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    table[i] = crc;
+  }
+  return table;
+}()};
+
+uint32_t crc32(span<const uint8_t> bytes) {
+  uint32_t crc{0xFFFFFFFFu};
+  for (auto byte : bytes)
+    crc = CrcTable[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+optional<uint8_t> ruleId(string_view rule) {
+  auto it{find(begin(Rules), end(Rules), rule)};
+  if (it == end(Rules))
+    return nullopt;
+  return static_cast<uint8_t>(distance(begin(Rules), it));
+}
+
+void putLittleEndian(vector<uint8_t> &bytes, uint64_t value, size_t size) {
+  for (size_t i{0}; i < size; i += 1)
+    bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+uint64_t getLittleEndian(span<const uint8_t> bytes) {
+  uint64_t value{0};
+  for (size_t i{0}; i < bytes.size(); i += 1)
+    value |= uint64_t{bytes[i]} << (8 * i);
+  return value;
+}
+} // namespace
+
+vector<uint8_t> toh::detail::encodeState(const GameBoard &game,
+                                         string_view rule,
+                                         milliseconds elapsed) {
+  vector<Position> pegs{};
+  for (auto &&position : {Left, Middle, Right}) {
+    for (auto &&disk : game.getTower(position)) {
+      if (disk > MaxSaveStateDisks)
+        throw invalid_argument{"too many disks for a save state"};
+      pegs.resize(max(pegs.size(), disk), End);
+      pegs[disk - 1] = position;
+    }
+  }
+  auto selection{End};
+  for (auto &&position : {Left, Middle, Right}) {
+    if (game.isSelected(position))
+      selection = position;
+  }
+
+  vector<uint8_t> bytes{begin(Magic), end(Magic)};
+  bytes.push_back(SaveStateVersion);
+  bytes.push_back(ruleId(rule).value_or(0xFF));
+  bytes.push_back(static_cast<uint8_t>(pegs.size()));
+  bytes.push_back(static_cast<uint8_t>(selection));
+  auto played{max(elapsed.count(), milliseconds::rep{0})};
+  putLittleEndian(bytes, static_cast<uint64_t>(played), 8);
+
+  bytes.resize(HeaderSize + (pegs.size() + 3) / 4, 0);
+  for (size_t i{0}; i < pegs.size(); i += 1)
+    bytes[HeaderSize + i / 4] |= static_cast<uint8_t>(pegs[i] << (i % 4 * 2));
+
+  putLittleEndian(bytes, crc32(bytes), ChecksumSize);
+  return bytes;
+}
+
+optional<toh::detail::DecodedState>
+toh::detail::decodeState(span<const uint8_t> bytes, string_view rule) {
+  if (bytes.size() < HeaderSize + ChecksumSize)
+    return nullopt;
+  auto body{bytes.first(bytes.size() - ChecksumSize)};
+  if (getLittleEndian(bytes.last(ChecksumSize)) != crc32(body))
+    return nullopt;
+  if (!equal(begin(Magic), end(Magic), begin(bytes)))
+    return nullopt;
+  if (bytes[4] != SaveStateVersion || bytes[5] != ruleId(rule))
+    return nullopt;
+
+  size_t disks{bytes[6]};
+  if (body.size() != HeaderSize + (disks + 3) / 4 || bytes[7] > End)
+    return nullopt;
+
+  DecodedState state{{}, static_cast<Position>(bytes[7]), {}};
+  state.elapsed = milliseconds{
+      static_cast<milliseconds::rep>(getLittleEndian(bytes.subspan(8, 8)))};
+  for (size_t i{0}; i < disks; i += 1) {
+    auto peg{(body[HeaderSize + i / 4] >> (i % 4 * 2)) & 0x3};
+    if (peg == End)
+      return nullopt;
+    state.pegs.push_back(static_cast<Position>(peg));
+  }
+  if (state.selection != End &&
+      find(begin(state.pegs), end(state.pegs), state.selection) ==
+          end(state.pegs))
+    return nullopt;
+  return state;
+}
+
+bool toh::saveToFile(const string &path, span<const uint8_t> bytes) {
+  auto temporary{path + ".tmp"};
+  ofstream file{temporary, ios::binary | ios::trunc};
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<streamsize>(bytes.size()));
+  file.close();
+  // Unlike std::rename, this replaces an existing save on Windows too.
+  error_code error{};
+  if (file)
+    filesystem::rename(temporary, path, error);
+  if (!file || error) {
+    filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+vector<uint8_t> toh::loadFromFile(const string &path) {
+  ifstream file{path, ios::binary};
+  vector<uint8_t> bytes(MaxSnapshotSize + 1);
+  file.read(reinterpret_cast<char *>(bytes.data()),
+            static_cast<streamsize>(bytes.size()));
+  auto size{static_cast<size_t>(file.gcount())};
+  // A larger file cannot be a snapshot; do not read the rest of it.
+  bytes.resize(size > MaxSnapshotSize ? 0 : size);
+  return bytes;
+}
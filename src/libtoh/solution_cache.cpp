@@ -0,0 +1,154 @@
+#include "libtoh/solution_cache.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+using RelabelTable = array<uint8_t, 256>;
+
+// Relabels both nibbles of a packed byte by a permutation of the towers.
+constexpr RelabelTable makeRelabelTable(array<uint8_t, 3> permutation) {
+  auto relabel{[&](unsigned move) {
+    auto from{move >> 2}, to{move & 3};
+    if (from > 2 || to > 2)
+      return move;
+    return unsigned{permutation[from]} << 2 | permutation[to];
+  }};
+
+  RelabelTable table{};
+  for (unsigned byte{0}; byte < table.size(); byte += 1) {
+    table[byte] =
+        static_cast<uint8_t>(relabel(byte >> 4) << 4 | relabel(byte & 0xF));
+  }
+  return table;
+}
+
+constexpr RelabelTable SwapMiddleRight{makeRelabelTable({Left, Right, Middle})};
+constexpr RelabelTable SwapLeftMiddle{makeRelabelTable({Middle, Left, Right})};
+constexpr uint8_t LeftToRight{Left << 2 | Right};
+
+// Clears the unused high nibble of the last byte of an odd number of moves.
+void clearPadding(vector<uint8_t> &moves, size_t size) {
+  if (size % 2 == 1)
+    moves.back() &= 0x0F;
+}
+} // namespace
+
+PackedSolution PackedSolution::extend() const {
+  PackedSolution next{};
+  next.m_disks = m_disks + 1;
+  next.m_moves.resize((next.size() + 1) / 2);
+
+  // Move n disks from src to tmp using dst as auxiliary
+  for (size_t i{0}; i < m_moves.size(); i += 1)
+    next.m_moves[i] = SwapMiddleRight[m_moves[i]];
+  // Move the (n+1)th disk from src to dst; `size()` is odd or zero, so this
+  // move lands in the high nibble of the last byte of the first half.
+  auto &middle{next.m_moves[size() / 2]};
+  middle = size() % 2 == 1
+               ? static_cast<uint8_t>((middle & 0x0F) | LeftToRight << 4)
+               : LeftToRight;
+  // Move n disks from tmp to dst using src as auxiliary, starting byte-aligned
+  auto offset{(size() + 1) / 2};
+  for (size_t i{0}; i < m_moves.size(); i += 1)
+    next.m_moves[offset + i] = SwapLeftMiddle[m_moves[i]];
+
+  clearPadding(next.m_moves, next.size());
+  return next;
+}
+
+PackedSolution PackedSolution::shrink(size_t disks) const {
+  if (disks >= m_disks)
+    return *this;
+
+  PackedSolution smaller{};
+  smaller.m_disks = disks;
+  smaller.m_moves.resize((smaller.size() + 1) / 2);
+  bool swap{(m_disks - disks) % 2 == 1};
+  for (size_t i{0}; i < smaller.m_moves.size(); i += 1)
+    smaller.m_moves[i] = swap ? SwapMiddleRight[m_moves[i]] : m_moves[i];
+
+  clearPadding(smaller.m_moves, smaller.size());
+  return smaller;
+}
+
+SolutionCache::SolutionCache(size_t memoryBudget) : m_budget{memoryBudget} {}
+
+SolutionCache &SolutionCache::instance() {
+  static SolutionCache cache{};
+  return cache;
+}
+
+shared_ptr<const PackedSolution> SolutionCache::acquire(size_t disk) {
+  shared_ptr<const PackedSolution> base{};
+  {
+    lock_guard guard{m_lock};
+    if (auto it{m_entries.find(disk)}; it != m_entries.end()) {
+      m_ages.splice(begin(m_ages), m_ages, it->second.age);
+      return it->second.solution;
+    }
+    if (auto larger{m_entries.upper_bound(disk)}; larger != end(m_entries))
+      base = larger->second.solution;
+    else if (!m_entries.empty())
+      base = prev(end(m_entries))->second.solution;
+  }
+
+  // Derive the solution without holding the lock; a concurrent caller may
+  // derive the same one, in which case the first to finish is kept.
+  PackedSolution derived{};
+  if (base && base->disks() >= disk) {
+    derived = base->shrink(disk);
+  } else {
+    if (base)
+      derived = base->extend();
+    while (derived.disks() < disk)
+      derived = derived.extend();
+  }
+  auto solution{make_shared<const PackedSolution>(std::move(derived))};
+
+  lock_guard guard{m_lock};
+  if (auto it{m_entries.find(disk)}; it != m_entries.end()) {
+    m_ages.splice(begin(m_ages), m_ages, it->second.age);
+    return it->second.solution;
+  }
+  if (solution->bytes() <= m_budget) {
+    m_ages.push_front(disk);
+    m_entries.emplace(disk, Entry{solution, begin(m_ages)});
+    m_usage += solution->bytes();
+    evict();
+  }
+  return solution;
+}
+
+void SolutionCache::setMemoryBudget(size_t bytes) {
+  lock_guard guard{m_lock};
+  m_budget = bytes;
+  evict();
+}
+
+size_t SolutionCache::memoryUsage() const {
+  lock_guard guard{m_lock};
+  return m_usage;
+}
+
+bool SolutionCache::contains(size_t disk) const {
+  lock_guard guard{m_lock};
+  return m_entries.contains(disk);
+}
+
+void SolutionCache::clear() {
+  lock_guard guard{m_lock};
+  m_entries.clear();
+  m_ages.clear();
+  m_usage = 0;
+}
+
+void SolutionCache::evict() {
+  while (m_usage > m_budget && !m_ages.empty()) {
+    auto oldest{m_ages.back()};
+    m_ages.pop_back();
+    auto it{m_entries.find(oldest)};
+    m_usage -= it->second.solution->bytes();
+    m_entries.erase(it);
+  }
+}
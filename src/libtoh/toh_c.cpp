@@ -0,0 +1,284 @@
+#include "libtoh/toh_c.h"
+
+#include <limits>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <variant>
+
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace toh;
+
+struct toh_game {
+  variant<Game, CyclicGame, AdjacentGame, BicolorGame> game;
+};
+
+namespace {
+using AnyGame = decltype(toh_game::game);
+
+optional<AnyGame> makeGame(toh_variant rules, const vector<Position> &pegs) {
+  switch (rules) {
+  case TOH_CLASSIC:
+    return AnyGame{in_place_type<Game>, pegs, End};
+  case TOH_CYCLIC:
+    return AnyGame{in_place_type<CyclicGame>, pegs, End};
+  case TOH_ADJACENT:
+    return AnyGame{in_place_type<AdjacentGame>, pegs, End};
+  case TOH_BICOLOR:
+    return AnyGame{in_place_type<BicolorGame>, pegs, End};
+  default:
+    return nullopt;
+  }
+}
+
+toh_game *create(toh_variant rules, const vector<Position> &pegs) {
+  auto game{makeGame(rules, pegs)};
+  if (!game)
+    return nullptr;
+  return new (nothrow) toh_game{std::move(*game)};
+}
+
+/*
+ * The rules are checked by the game itself: a move that leaves a tower
+ * selected was refused. Dispatching once per batch keeps the loop free of
+ * any branch on the variant.
+ */
+template <typename GameType>
+size_t applyMoves(GameType &game, const uint8_t *moves, size_t count) {
+  game.select(End);
+  for (size_t i{0}; i < count; i += 1) {
+    auto from{moves[2 * i]};
+    auto to{moves[2 * i + 1]};
+    if (from >= End || to >= End || from == to ||
+        game.getTower(static_cast<Position>(from)).empty())
+      return i;
+    game.select(static_cast<Position>(from));
+    game.select(static_cast<Position>(to));
+    if (!game.isSelected(End)) {
+      game.select(End);
+      return i;
+    }
+  }
+  return count;
+}
+
+toh_status batchStatus(size_t done, size_t count, size_t *result) {
+  if (result)
+    *result = done;
+  return done == count ? TOH_OK : TOH_ERROR_ILLEGAL_MOVE;
+}
+
+// The length of the optimal solution, if twice of it fits in a size_t.
+optional<size_t> solutionLength(toh_variant rules, size_t disks) {
+  constexpr auto Limit{numeric_limits<size_t>::max() / 2};
+  size_t length{0};
+  size_t oneStep{0};
+  for (size_t disk{0}; disk < disks; disk += 1) {
+    switch (rules) {
+    case TOH_CLASSIC:
+    case TOH_BICOLOR:
+      if (length > (Limit - 1) / 2)
+        return nullopt;
+      length = 2 * length + 1;
+      break;
+    case TOH_ADJACENT:
+      if (length > (Limit - 2) / 3)
+        return nullopt;
+      length = 3 * length + 2;
+      break;
+    case TOH_CYCLIC:
+      // See detail::solveCyclicTwoSteps and detail::solveCyclicOneStep.
+      if (length > (Limit - 2 - oneStep) / 2)
+        return nullopt;
+      tie(length, oneStep) = pair{2 * length + oneStep + 2, 2 * length + 1};
+      break;
+    default:
+      return nullopt;
+    }
+  }
+  return length;
+}
+
+// Writes selections straight into the buffer of the caller, which
+// solutionLength() has checked is large enough.
+struct BufferSink {
+  uint8_t *next;
+
+  void push_back(uint8_t selection) { *next++ = selection; }
+};
+
+template <typename GameType> void solve(size_t disks, uint8_t *moves) {
+  BufferSink sink{moves};
+  GameType::RuleType::solve(sink, disks, uint8_t{Left}, uint8_t{Middle},
+                            uint8_t{Right});
+}
+} // namespace
+
+int toh_api_version(void) { return TOH_C_API_VERSION; }
+
+toh_game *toh_game_create(toh_variant rules, size_t disks) {
+  try {
+    return create(rules, vector<Position>(disks, Left));
+  } catch (const exception &) {
+    return nullptr;
+  }
+}
+
+toh_game *toh_game_create_from_pegs(toh_variant rules, const uint8_t *pegs,
+                                    size_t disks) {
+  if (!pegs && disks > 0)
+    return nullptr;
+  try {
+    vector<Position> towers(disks);
+    for (size_t i{0}; i < disks; i += 1) {
+      if (pegs[i] >= End)
+        return nullptr;
+      towers[i] = static_cast<Position>(pegs[i]);
+    }
+    return create(rules, towers);
+  } catch (const exception &) {
+    return nullptr;
+  }
+}
+
+toh_game *toh_game_clone(const toh_game *game) {
+  if (!game)
+    return nullptr;
+  try {
+    return new (nothrow) toh_game{game->game};
+  } catch (const exception &) {
+    return nullptr;
+  }
+}
+
+void toh_game_destroy(toh_game *game) { delete game; }
+
+toh_variant toh_game_variant(const toh_game *game) {
+  return static_cast<toh_variant>(game->game.index());
+}
+
+size_t toh_game_disks(const toh_game *game) {
+  if (!game)
+    return 0;
+  return visit(
+      [](auto &&board) {
+        return board.getTower(Left).size() + board.getTower(Middle).size() +
+               board.getTower(Right).size();
+      },
+      game->game);
+}
+
+int toh_game_is_finished(const toh_game *game) {
+  if (!game)
+    return 0;
+  return visit([](auto &&board) { return board.isFinished() ? 1 : 0; },
+               game->game);
+}
+
+int toh_game_selection(const toh_game *game) {
+  if (!game)
+    return TOH_END;
+  return visit(
+      [](auto &&board) {
+        for (auto &&position : {Left, Middle, Right}) {
+          if (board.isSelected(position))
+            return static_cast<int>(position);
+        }
+        return static_cast<int>(TOH_END);
+      },
+      game->game);
+}
+
+toh_status toh_game_pegs(const toh_game *game, uint8_t *pegs,
+                         size_t capacity) {
+  if (!game || (!pegs && capacity > 0))
+    return TOH_ERROR_ARGUMENT;
+  if (capacity < toh_game_disks(game))
+    return TOH_ERROR_BUFFER_TOO_SMALL;
+  visit(
+      [pegs](auto &&board) {
+        for (auto &&position : {Left, Middle, Right}) {
+          for (auto &&disk : board.getTower(position))
+            pegs[disk - 1] = static_cast<uint8_t>(position);
+        }
+      },
+      game->game);
+  return TOH_OK;
+}
+
+toh_status toh_game_select(toh_game *game, int tower) {
+  if (!game || tower < TOH_LEFT || tower > TOH_END)
+    return TOH_ERROR_ARGUMENT;
+  try {
+    visit([tower](auto &&board) { board.select(static_cast<Position>(tower)); },
+          game->game);
+  } catch (const exception &) {
+    return TOH_ERROR_NO_MEMORY;
+  }
+  return TOH_OK;
+}
+
+toh_status toh_game_apply(toh_game *game, const uint8_t *moves, size_t count,
+                          size_t *applied) {
+  if (!game || (!moves && count > 0))
+    return TOH_ERROR_ARGUMENT;
+  try {
+    auto done{visit(
+        [moves, count](auto &&board) {
+          return applyMoves(board, moves, count);
+        },
+        game->game)};
+    return batchStatus(done, count, applied);
+  } catch (const exception &) {
+    return TOH_ERROR_NO_MEMORY;
+  }
+}
+
+toh_status toh_game_validate(const toh_game *game, const uint8_t *moves,
+                             size_t count, size_t *valid) {
+  if (!game || (!moves && count > 0))
+    return TOH_ERROR_ARGUMENT;
+  try {
+    auto done{visit(
+        [moves, count](auto board) { return applyMoves(board, moves, count); },
+        game->game)};
+    return batchStatus(done, count, valid);
+  } catch (const exception &) {
+    return TOH_ERROR_NO_MEMORY;
+  }
+}
+
+toh_status toh_solve(toh_variant rules, size_t disks, uint8_t *moves,
+                     size_t capacity, size_t *count) {
+  auto length{solutionLength(rules, disks)};
+  if (!length || !count || (!moves && capacity > 0))
+    return TOH_ERROR_ARGUMENT;
+  *count = *length;
+  if (capacity < *length)
+    return TOH_ERROR_BUFFER_TOO_SMALL;
+  if (*length == 0)
+    return TOH_OK;
+  try {
+    switch (rules) {
+    case TOH_CLASSIC:
+      solve<Game>(disks, moves);
+      break;
+    case TOH_CYCLIC:
+      solve<CyclicGame>(disks, moves);
+      break;
+    case TOH_ADJACENT:
+      solve<AdjacentGame>(disks, moves);
+      break;
+    case TOH_BICOLOR:
+      solve<BicolorGame>(disks, moves);
+      break;
+    default:
+      return TOH_ERROR_ARGUMENT;
+    }
+  } catch (const exception &) {
+    return TOH_ERROR_NO_MEMORY;
+  }
+  return TOH_OK;
+}
@@ -1,38 +1,68 @@
 #include "libtoh/toh_model.h"
 
+#include "libtoh/metrics.h"
+
 using namespace std;
 using namespace toh;
 
-Game::Game(size_t size) {
+GameBoard::GameBoard(size_t size) {
   for (size_t i{size}; i > 0; i -= 1)
     m_towers[Left].push_back(i);
 }
 
-bool Game::move(Position from, Position to) {
-  if (from == End || to == End)
-    return false;
+GameBoard::GameBoard(const vector<Position> &pegs, Position selection)
+    : m_selection{selection} {
+  for (size_t i{pegs.size()}; i > 0; i -= 1)
+    m_towers[pegs[i - 1]].push_back(i);
+}
+
+bool GameBoard::isFinished() const {
+  return m_towers[Left].size() == 0 && m_towers[Middle].size() == 0;
+}
+
+const vector<size_t> &GameBoard::getTower(Position position) const {
+  return m_towers[position];
+}
+
+bool GameBoard::isSelected(Position position) const {
+  return position == m_selection;
+}
 
-  if (!m_towers[to].empty()) {
-    if (m_towers[from].back() >= m_towers[to].back())
-      return false;
+template <typename Rule>
+BasicGame<Rule>::BasicGame(size_t size) : GameBoard{size} {}
+
+template <typename Rule>
+BasicGame<Rule>::BasicGame(const vector<Position> &pegs, Position selection)
+    : GameBoard{pegs, selection} {}
+
+template <typename Rule>
+bool BasicGame<Rule>::move(Position from, Position to) {
+  TOH_TRACE_SCOPE("Game::move");
+  if (from == End || to == End || !Rule::canMove(from, to) ||
+      (!m_towers[to].empty() &&
+       !Rule::canStack(m_towers[from].back(), m_towers[to].back()))) {
+    TOH_METRICS_INCREMENT(RejectedMoves);
+    return false;
   }
 
   auto disk{m_towers[from].back()};
   m_towers[from].pop_back();
   m_towers[to].push_back(disk);
+  TOH_METRICS_INCREMENT(Moves);
   return true;
 }
 
-void Game::select(Position position) {
+template <typename Rule> void BasicGame<Rule>::select(Position position) {
+  TOH_TRACE_SCOPE("Game::select");
+  TOH_METRICS_INCREMENT(Selects);
   if (position == End) {
     m_selection = End;
     return;
   }
   if (m_selection == End) {
-    if (!m_towers[position].empty()) {
+    if (!m_towers[position].empty())
       m_selection = position;
-      return;
-    }
+    return;
   }
   if (m_selection == position) {
     m_selection = End;
@@ -44,14 +74,7 @@ void Game::select(Position position) {
   }
 }
 
-bool Game::isFinished() const {
-  return m_towers[Left].size() == 0 && m_towers[Middle].size() == 0;
-}
-
-const vector<size_t> &Game::getTower(Position position) const {
-  return m_towers[position];
-}
-
-bool Game::isSelected(Position position) const {
-  return position == m_selection;
-}
+template class toh::BasicGame<ClassicRule>;
+template class toh::BasicGame<CyclicRule>;
+template class toh::BasicGame<AdjacentRule>;
+template class toh::BasicGame<BicolorRule>;
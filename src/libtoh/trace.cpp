@@ -0,0 +1,151 @@
+#include "libtoh/trace.h"
+
+#ifdef TOH_ENABLE_TRACING
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <new>
+#endif
+
+using namespace std;
+
+#ifdef TOH_ENABLE_TRACING
+namespace {
+constexpr size_t BufferCapacity{size_t{1} << 16};
+// Buffers grow a chunk at a time, so a thread recording a few zones costs a
+// few kilobytes and not the whole capacity.
+constexpr size_t ChunkEvents{1024};
+constexpr size_t ChunkCount{BufferCapacity / ChunkEvents};
+
+struct Event {
+  const char *name;
+  int64_t start;
+  int64_t duration;
+};
+
+using Chunk = array<Event, ChunkEvents>;
+
+/*
+ * Each thread owns one buffer and is its only writer. Publishing an event is a
+ * plain store followed by a release store of the size, so readers that
+ * acquire the size see complete events, and the chunks holding them, without
+ * locking the writer. Events recorded after the buffer is full, or when no
+ * chunk can be allocated, are counted and dropped.
+ */
+struct Buffer {
+  explicit Buffer(uint32_t id) : tid{id} {}
+
+  Event &operator[](size_t index) const {
+    return (*chunks[index / ChunkEvents])[index % ChunkEvents];
+  }
+
+  uint32_t tid;
+  atomic<size_t> size{0};
+  atomic<size_t> dropped{0};
+  array<unique_ptr<Chunk>, ChunkCount> chunks{};
+};
+
+struct Registry {
+  mutex lock{};
+  vector<shared_ptr<Buffer>> buffers{};
+  uint32_t nextTid{1};
+};
+
+Registry &registry() {
+  static Registry instance{};
+  return instance;
+}
+
+const chrono::steady_clock::time_point Epoch{chrono::steady_clock::now()};
+
+int64_t now() {
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now() - Epoch)
+      .count();
+}
+
+Buffer &localBuffer() {
+  // Registration takes the lock once per thread; recording never does.
+  thread_local shared_ptr<Buffer> buffer{[] {
+    auto &instance{registry()};
+    lock_guard guard{instance.lock};
+    auto created{make_shared<Buffer>(instance.nextTid++)};
+    instance.buffers.push_back(created);
+    return created;
+  }()};
+  return *buffer;
+}
+
+void writeName(ostream &out, const char *name) {
+  for (; *name; name += 1) {
+    if (*name == '"' || *name == '\\')
+      out << '\\';
+    out << *name;
+  }
+}
+
+void writeMicroseconds(ostream &out, int64_t nanoseconds) {
+  auto fraction{nanoseconds % 1000};
+  out << nanoseconds / 1000 << '.' << fraction / 100 << fraction / 10 % 10
+      << fraction % 10;
+}
+} // namespace
+
+toh::trace::Zone::Zone(const char *name) noexcept
+    : m_name{name}, m_start{now()} {}
+
+toh::trace::Zone::~Zone() {
+  auto end{now()};
+  auto &buffer{localBuffer()};
+  auto index{buffer.size.load(memory_order_relaxed)};
+  auto &chunk{buffer.chunks[min(index, BufferCapacity - 1) / ChunkEvents]};
+  if (index < BufferCapacity && !chunk)
+    chunk.reset(new (nothrow) Chunk{});
+  if (index == BufferCapacity || !chunk) {
+    buffer.dropped.fetch_add(1, memory_order_relaxed);
+    return;
+  }
+  buffer[index] = Event{m_name, m_start, end - m_start};
+  buffer.size.store(index + 1, memory_order_release);
+}
+
+void toh::trace::writeChromeTrace(ostream &out) {
+  auto &instance{registry()};
+  lock_guard guard{instance.lock};
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first{true};
+  for (auto &&buffer : instance.buffers) {
+    auto size{buffer->size.load(memory_order_acquire)};
+    for (size_t i{0}; i < size; i += 1) {
+      auto &event{(*buffer)[i]};
+      out << (first ? "" : ",") << "\n{\"name\":\"";
+      writeName(out, event.name);
+      out << "\",\"cat\":\"toh\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+          << ",\"ts\":";
+      writeMicroseconds(out, event.start);
+      out << ",\"dur\":";
+      writeMicroseconds(out, event.duration);
+      out << "}";
+      first = false;
+    }
+    auto dropped{buffer->dropped.load(memory_order_relaxed)};
+    if (dropped > 0) {
+      out << (first ? "" : ",")
+          << "\n{\"name\":\"dropped\",\"cat\":\"toh\",\"ph\":\"i\",\"s\":"
+             "\"t\",\"pid\":1,\"tid\":"
+          << buffer->tid << ",\"ts\":0,\"args\":{\"events\":" << dropped
+          << "}}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+}
+#else
+void toh::trace::writeChromeTrace(ostream &out) {
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}\n";
+}
+#endif
@@ -0,0 +1,90 @@
+#include "toh/auto_solver.h"
+
+#include <type_traits>
+
+#include "libtoh/optimal_path.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+// Unwinds a recursive solver once the solver is stopping.
+struct Stopped {};
+
+// Plays the selections of a recursive solver as it produces them.
+template <typename Select> struct SelectionSink {
+  Select &select;
+
+  void push_back(Position selection) {
+    if (!select(selection))
+      throw Stopped{};
+  }
+};
+} // namespace
+
+template <typename GameType>
+BasicAutoSolver<GameType>::BasicAutoSolver(size_t disks,
+                                           steady_clock::duration pace,
+                                           function<void()> published)
+    : m_disks{disks}, m_pace{pace}, m_published{std::move(published)},
+      m_snapshot{GameSnapshot::of(GameType{disks})},
+      m_thread{[this] { play(); }} {}
+
+template <typename GameType> BasicAutoSolver<GameType>::~BasicAutoSolver() {
+  {
+    lock_guard guard{m_lock};
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+template <typename GameType>
+GameSnapshot BasicAutoSolver<GameType>::snapshot() const {
+  return m_snapshot.load();
+}
+
+template <typename GameType> void BasicAutoSolver<GameType>::play() {
+  using RuleType = typename GameType::RuleType;
+  GameType game{m_disks};
+  uint64_t moves{0};
+  auto select{[&](Position selection) {
+    if (!wait())
+      return false;
+    game.select(selection);
+    if (game.isSelected(End))
+      moves += 1;
+    m_snapshot.store(GameSnapshot::of(game, moves));
+    m_published();
+    return true;
+  }};
+
+  // The solution of a large game does not fit in memory, so it is never
+  // stored: the classic one is computed a move at a time, the others are
+  // played from inside their recursive solver, one frame per disk deep.
+  if constexpr (is_same_v<RuleType, ClassicRule> ||
+                is_same_v<RuleType, BicolorRule>) {
+    for (uint64_t i{0}; i < optimalLength(m_disks); i += 1) {
+      auto move{optimalMove(m_disks, i)};
+      if (!select(move.from) || !select(move.to))
+        return;
+    }
+  } else {
+    SelectionSink<decltype(select)> sink{select};
+    try {
+      RuleType::solve(sink, m_disks, Left, Middle, Right);
+    } catch (const Stopped &) {
+    }
+  }
+}
+
+template <typename GameType> bool BasicAutoSolver<GameType>::wait() {
+  unique_lock lock{m_lock};
+  return !m_wake.wait_for(lock, m_pace, [this] { return m_stopping; });
+}
+
+template class BasicAutoSolver<Game>;
+template class BasicAutoSolver<CyclicGame>;
+template class BasicAutoSolver<AdjacentGame>;
+template class BasicAutoSolver<BicolorGame>;
@@ -0,0 +1,292 @@
+#include "toh/diff_toh.h"
+
+#include "libtoh/metrics.h"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace ftxui;
+using namespace toh;
+
+namespace {
+// The background colours of GameViewer, as SGR parameters.
+constexpr array<string_view, 10> ColorCodes{
+    "40", "103", "101", "105", "102", "106", "104", "47", "100", "48;5;215"};
+constexpr string_view Reset{"\x1b[0m"};
+constexpr string_view HelpText{
+    "(q)->quit, (+/-)->add/remove disks, (a/j)->select left, "
+    "(s/k)->select middle, (d/l)->select right"};
+
+string moveCursor(size_t row, size_t column) {
+  return format("\x1b[{};{}H", row + 1, column + 1);
+}
+
+#if !defined(_WIN32)
+volatile sig_atomic_t Resized{0};
+
+// Puts the terminal in raw mode on the alternate screen and restores it,
+// whichever way the game ends.
+class RawTerminal {
+public:
+  RawTerminal() {
+    m_active = tcgetattr(STDIN_FILENO, &m_saved) == 0;
+    if (!m_active)
+      return;
+    auto raw{m_saved};
+    cfmakeraw(&raw);
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+
+    struct sigaction action {};
+    action.sa_handler = [](int) { Resized = 1; };
+    sigaction(SIGWINCH, &action, &m_savedAction);
+    write("\x1b[?1049h\x1b[?25l");
+  }
+
+  RawTerminal(const RawTerminal &) = delete;
+  RawTerminal &operator=(const RawTerminal &) = delete;
+
+  ~RawTerminal() {
+    if (!m_active)
+      return;
+    write("\x1b[0m\x1b[?25h\x1b[?1049l");
+    sigaction(SIGWINCH, &m_savedAction, nullptr);
+    tcsetattr(STDIN_FILENO, TCSANOW, &m_saved);
+  }
+
+  bool active() const { return m_active; }
+
+  pair<size_t, size_t> size() const {
+    winsize size{};
+    ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
+    return {size.ws_col, size.ws_row};
+  }
+
+  static void write(string_view output) {
+    while (!output.empty()) {
+      auto count{::write(STDOUT_FILENO, output.data(), output.size())};
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        return;
+      output.remove_prefix(static_cast<size_t>(count));
+    }
+  }
+
+private:
+  termios m_saved{};
+  struct sigaction m_savedAction {};
+  bool m_active{false};
+};
+#endif
+} // namespace
+
+DiffRenderer::DiffRenderer(const toh::GameBoard &game, size_t width,
+                           size_t height)
+    : m_game{game}, m_width{width}, m_height{height} {}
+
+void DiffRenderer::resize(size_t width, size_t height) {
+  m_width = width;
+  m_height = height;
+  m_repaint = true;
+}
+
+string DiffRenderer::render() {
+  TOH_TRACE_SCOPE("DiffRenderer::render");
+  TOH_METRICS_INCREMENT(FramesRendered);
+  auto legendChanged{updateCompletionTime()};
+  auto frame{layout()};
+  // Every width scales with the number of disks.
+  auto disks{towerLayout().disks};
+  if (disks != m_disks) {
+    m_disks = disks;
+    m_repaint = true;
+  }
+
+  string output{};
+  if (m_repaint || frame.size() != m_frame.size()) {
+    output = repaint(frame);
+    m_repaint = false;
+  } else {
+    for (size_t row{0}; row < frame.size(); row += 1) {
+      for (auto &&position : {Left, Middle, Right}) {
+        if (frame[row][position] != m_frame[row][position])
+          output += paintCell(row, position, m_frame[row][position],
+                              frame[row][position]);
+      }
+    }
+    if (legendChanged)
+      output += paintLegend();
+  }
+
+  m_frame = std::move(frame);
+  return output;
+}
+
+steady_clock::duration DiffRenderer::elapsed() const {
+  if (m_completionDuration.count())
+    return m_completionDuration;
+  if (m_startTime == steady_clock::time_point{})
+    return steady_clock::duration{};
+  return steady_clock::now() - m_startTime;
+}
+
+void DiffRenderer::resume(steady_clock::duration elapsed) {
+  if (elapsed <= steady_clock::duration{})
+    return;
+  m_startTime = steady_clock::now() - elapsed;
+  if (m_game.isFinished())
+    m_completionDuration = elapsed;
+}
+
+TowerLayout DiffRenderer::towerLayout() const {
+  TowerLayout layout{};
+  for (auto &&position : {Left, Middle, Right})
+    layout.disks += m_game.getTower(position).size();
+  layout.columns = m_width > 2 ? (m_width - 2) / 3 : 0;
+  layout.rows = m_height > 2 ? m_height - 2 : 0;
+  return layout;
+}
+
+DiffRenderer::Frame DiffRenderer::layout() const {
+  auto towers{towerLayout()};
+  Frame frame(towers.rows, {0, 0, 0});
+  for (auto &&position : {Left, Middle, Right}) {
+    auto tower{towers.visibleRows(m_game.getTower(position))};
+    auto height{tower.size()};
+    for (size_t i{0}; i < height; i += 1)
+      frame[frame.size() - 1 - i][position] = tower[i];
+    // A selected tower lifts its top disk to the top row.
+    if (m_game.isSelected(position) && height && height < frame.size()) {
+      swap(frame[0][position], frame[frame.size() - height][position]);
+    }
+  }
+  return frame;
+}
+
+string DiffRenderer::repaint(const Frame &frame) const {
+  auto column{m_width > 2 ? (m_width - 2) / 3 : 0};
+  string output{format("{}\x1b[2J", Reset)};
+  for (size_t row{0}; row < frame.size(); row += 1) {
+    output += moveCursor(row, column) + "│";
+    output += moveCursor(row, 2 * column + 1) + "│";
+    for (auto &&position : {Left, Middle, Right}) {
+      if (frame[row][position])
+        output += paintCell(row, position, 0, frame[row][position]);
+    }
+  }
+  if (m_height > 1) {
+    output += moveCursor(m_height - 2, 0);
+    for (size_t i{0}; i < m_width; i += 1)
+      output += "─";
+  }
+  return output + paintLegend();
+}
+
+string DiffRenderer::paintCell(size_t row, size_t tower, size_t before,
+                               size_t after) const {
+  auto layout{towerLayout()};
+  auto center{tower * (layout.columns + 1) + layout.columns / 2};
+  auto disk{layout.halfWidth(after)};
+  auto span{max(layout.halfWidth(before), disk)};
+  if (span == 0)
+    return {};
+
+  auto output{moveCursor(row, center - span) + string{Reset}};
+  output += string(span - disk, ' ');
+  if (disk) {
+    output += format("\x1b[{}m", ColorCodes[after % ColorCodes.size()]);
+    output += string(2 * disk, ' ');
+    output += Reset;
+  }
+  return output + string(span - disk, ' ');
+}
+
+string DiffRenderer::paintLegend() const {
+  if (m_height == 0)
+    return {};
+
+  string duration{};
+  if (m_finished) {
+    duration = format(
+        "Completed in {:.3f} (s)",
+        duration_cast<milliseconds>(m_completionDuration).count() / 1000.0);
+  }
+  // The time is worth more than the end of the help text.
+  if (duration.size() > m_width)
+    duration.clear();
+  auto help{HelpText.substr(0, m_width - duration.size())};
+  auto gap{m_width - help.size()};
+
+  return format("{}{}\x1b[2K{}{}{}", moveCursor(m_height - 1, 0), Reset, help,
+                string(gap - duration.size(), ' '), duration);
+}
+
+bool DiffRenderer::updateCompletionTime() {
+  if (m_finished && !m_game.isFinished()) {
+    m_finished = false;
+    m_completionDuration = steady_clock::duration{};
+    m_startTime = steady_clock::time_point{};
+    return true;
+  }
+  if (m_startTime == steady_clock::time_point{} && m_game.isSelected(Left)) {
+    m_startTime = steady_clock::now();
+  }
+  if (!m_finished && m_game.isFinished()) {
+    m_finished = true;
+    m_completionDuration = steady_clock::now() - m_startTime;
+    return true;
+  }
+  return false;
+}
+
+template <typename GameType>
+int runDiffTerminal(GameType &game, steady_clock::duration &elapsed) {
+#if !defined(_WIN32)
+  RawTerminal terminal{};
+  if (!terminal.active())
+    return 1;
+
+  // Never installed; the controller only asks it to exit.
+  auto screen{ScreenInteractive::FixedSize(0, 0)};
+  BasicGameController<GameType> controller{game, screen};
+  auto [width, height]{terminal.size()};
+  DiffRenderer renderer{game, width, height};
+  renderer.resume(elapsed);
+
+  while (true) {
+    if (Resized) {
+      Resized = 0;
+      auto [columns, rows]{terminal.size()};
+      renderer.resize(columns, rows);
+    }
+    RawTerminal::write(renderer.render());
+
+    char key{};
+    auto count{read(STDIN_FILENO, &key, 1)};
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0 || key == 'q')
+      break;
+    controller(Event::Character(key));
+  }
+  elapsed = renderer.elapsed();
+  return 0;
+#else
+  static_cast<void>(game);
+  static_cast<void>(elapsed);
+  return 1;
+#endif
+}
+
+template int runDiffTerminal(Game &, steady_clock::duration &);
+template int runDiffTerminal(CyclicGame &, steady_clock::duration &);
+template int runDiffTerminal(AdjacentGame &, steady_clock::duration &);
+template int runDiffTerminal(BicolorGame &, steady_clock::duration &);
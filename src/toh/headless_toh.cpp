@@ -0,0 +1,83 @@
+#include "toh/headless_toh.h"
+
+using namespace std;
+using namespace chrono;
+using namespace ftxui;
+using namespace toh;
+
+template <typename GameType>
+BasicHeadlessSession<GameType>::BasicHeadlessSession(GameType &game,
+                                                     bool render, int width,
+                                                     int height)
+    : m_screen{ScreenInteractive::FixedSize(width, height)},
+      m_canvas{width, height}, m_viewer{game}, m_controller{game, m_screen},
+      m_component{m_viewer.createView()}, m_render{render} {
+  m_component |= CatchEvent(m_controller);
+}
+
+template <typename GameType>
+HeadlessReport BasicHeadlessSession<GameType>::run(std::istream &script) & {
+  HeadlessReport report{};
+  auto start{steady_clock::now()};
+
+  char key{};
+  while (nextKey(script, key)) {
+    report.events += 1;
+    if (m_component->OnEvent(Event::Character(key)))
+      report.handled += 1;
+    if (m_render)
+      Render(m_canvas, m_component->Render());
+    // The controller only asks the screen to exit, which is a no-op for a
+    // screen that never looped; stop reading here instead.
+    if (key == 'q')
+      break;
+  }
+
+  report.elapsed = steady_clock::now() - start;
+  return report;
+}
+
+template <typename GameType>
+const Screen &BasicHeadlessSession<GameType>::canvas() const {
+  return m_canvas;
+}
+
+template <typename GameType>
+bool BasicHeadlessSession<GameType>::nextKey(std::istream &script,
+                                             char &key) {
+  while (script.get(key)) {
+    if (key == '#') {
+      script.ignore(numeric_limits<streamsize>::max(), '\n');
+      continue;
+    }
+    if (isspace(static_cast<unsigned char>(key)))
+      continue;
+    return true;
+  }
+  return false;
+}
+
+template class BasicHeadlessSession<Game>;
+template class BasicHeadlessSession<CyclicGame>;
+template class BasicHeadlessSession<AdjacentGame>;
+template class BasicHeadlessSession<BicolorGame>;
+
+string formatHeadlessReport(const toh::GameBoard &game,
+                            const HeadlessReport &report) {
+  auto formatTower{[&](Position position) {
+    string disks{};
+    for (auto &&disk : game.getTower(position))
+      disks += format("{}{}", disks.empty() ? "" : " ", disk);
+    return disks;
+  }};
+
+  auto seconds{duration<double>(report.elapsed).count()};
+  auto rate{seconds > 0 ? static_cast<double>(report.events) / seconds : 0.0};
+
+  return format("left: [{}]\nmiddle: [{}]\nright: [{}]\nfinished: {}\n"
+                "events: {} ({} handled)\nelapsed: {:.6f} (s)\n"
+                "rate: {:.0f} (events/s)",
+                formatTower(Left), formatTower(Middle), formatTower(Right),
+                game.isFinished(), report.events, report.handled, seconds,
+                rate);
+}
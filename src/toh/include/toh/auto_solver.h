@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "libtoh/game_snapshot.h"
+#include "libtoh/seqlock.h"
+#include "libtoh/toh_model.h"
+
+/**
+ * @class BasicAutoSolver
+ * @brief Plays the optimal solution of a new game on a worker thread and
+ * publishes every selection as a snapshot.
+ *
+ * The worker owns its game; the UI thread only ever sees copies taken through
+ * a toh::SeqLock, so rendering never races with the solver and never makes it
+ * wait. Solving, pacing and playing all happen on the worker. The solution is
+ * played as it is computed and never stored, so the worker needs memory
+ * linear in the number of disks.
+ *
+ * @tparam GameType The game type, a toh::BasicGame of any rule policy.
+ *
+ * ### Example
+ * ```cpp
+ * #include "ftxui/component/screen_interactive.hpp"
+ * #include "toh/auto_solver.h"
+ * #include "toh/terminal_toh.h"
+ *
+ * using namespace std;
+ * using namespace ftxui;
+ * using namespace toh;
+ *
+ * int main() {
+ *   auto screen{ScreenInteractive::Fullscreen()};
+ *   GameBoard board{5};
+ *   GameViewer viewer{board};
+ *   BasicAutoSolver<Game> solver{5, chrono::milliseconds{100},
+ *                                [&] { screen.PostEvent(Event::Custom); }};
+ *
+ *   auto view{viewer.createView()};
+ *   screen.Loop(Renderer(view, [&] {
+ *     board = solver.snapshot().board();
+ *     return view->Render();
+ *   }));
+ * }
+ * ```
+ */
+template <typename GameType> class BasicAutoSolver {
+public:
+  /**
+   * @brief Starts solving a new game.
+   * @param disks The number of disks, at most toh::MaxSnapshotDisks.
+   * @param pace The time between two selections.
+   * @param published Called on the worker after every new snapshot.
+   */
+  BasicAutoSolver(size_t disks, std::chrono::steady_clock::duration pace,
+                  std::function<void()> published);
+
+  /**
+   * @brief Deleted copy constructor.
+   *
+   * The worker refers to the solver.
+   * @param src The source BasicAutoSolver object (unused).
+   */
+  BasicAutoSolver(const BasicAutoSolver &src) = delete;
+
+  /**
+   * @brief Deleted move constructor.
+   *
+   * @param src The source BasicAutoSolver object (unused).
+   */
+  BasicAutoSolver(BasicAutoSolver &&src) noexcept = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @param src The source BasicAutoSolver object (unused).
+   * @return Deleted.
+   */
+  BasicAutoSolver &operator=(const BasicAutoSolver &src) = delete;
+
+  /**
+   * @brief Deleted move assignment operator.
+   *
+   * @param src The source BasicAutoSolver object (unused).
+   * @return Deleted.
+   */
+  BasicAutoSolver &operator=(BasicAutoSolver &&src) noexcept = delete;
+
+  /**
+   * @brief Stops the worker, even halfway through the solution, and waits for
+   * it to finish.
+   */
+  ~BasicAutoSolver();
+
+  /**
+   * @brief Gets the last published state of the game.
+   *
+   * Never blocks the worker; may be called from any thread.
+   * @return The snapshot.
+   */
+  [[nodiscard]] toh::GameSnapshot snapshot() const;
+
+private:
+  /**
+   * @brief The body of the worker thread.
+   */
+  void play();
+
+  /**
+   * @brief Waits for one pace unless the solver is stopping.
+   * @return false if the solver is stopping.
+   */
+  bool wait();
+
+private:
+  size_t m_disks; ///< The number of disks of the game.
+  std::chrono::steady_clock::duration m_pace; ///< The time between selections.
+  std::function<void()> m_published; ///< Called after every new snapshot.
+  toh::SeqLock<toh::GameSnapshot> m_snapshot; ///< The last published state.
+  std::mutex m_lock;                          ///< Guards m_stopping.
+  std::condition_variable m_wake;             ///< Cuts a wait short.
+  bool m_stopping{false};                     ///< Whether the worker must exit.
+  std::thread m_thread;                       ///< The worker, started last.
+};
+
+extern template class BasicAutoSolver<toh::Game>;
+extern template class BasicAutoSolver<toh::CyclicGame>;
+extern template class BasicAutoSolver<toh::AdjacentGame>;
+extern template class BasicAutoSolver<toh::BicolorGame>;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "libtoh/toh_model.h"
+#include "toh/terminal_toh.h"
+#include "toh/tower_layout.h"
+
+/**
+ * @class DiffRenderer
+ * @brief Renders a game as raw ANSI output, repainting only what changed.
+ *
+ * The renderer lays the towers out as a grid of rows, one disk per row and
+ * tower, fitted to the terminal with a TowerLayout, and remembers the grid it
+ * painted last. Each call to render()
+ * compares the next grid with the previous one and emits a cursor-addressed
+ * update for every cell that differs, restricted to the columns covered by
+ * either disk. A move therefore costs two small updates, and selecting a
+ * tower, which lifts its top disk to the top row, costs two more. The first
+ * frame, and the first frame after resize() or after the number of disks
+ * changes, is a full repaint.
+ *
+ * The renderer works on the game model directly rather than on FTXUI
+ * elements, which keeps the output small enough for slow remote terminals.
+ *
+ * ### Example
+ * ```cpp
+ * #include "libtoh/toh_model.h"
+ * #include "toh/diff_toh.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   Game game{3};
+ *   DiffRenderer renderer{game, 80, 24};
+ *
+ *   cout << renderer.render(); // Full repaint
+ *   game.select(Left);
+ *   game.select(Right);
+ *   cout << renderer.render() << flush; // Two rows
+ * }
+ * ```
+ */
+class DiffRenderer {
+public:
+  /**
+   * @brief Constructs a DiffRenderer for a game and a terminal size.
+   * @param game A reference to the game to render, of any variant.
+   * @param width The number of columns of the terminal.
+   * @param height The number of rows of the terminal.
+   */
+  explicit DiffRenderer(const toh::GameBoard &game, size_t width,
+                        size_t height);
+
+  /**
+   * @brief Changes the size of the terminal.
+   *
+   * The next call to render() repaints the whole screen.
+   * @param width The number of columns of the terminal.
+   * @param height The number of rows of the terminal.
+   */
+  void resize(size_t width, size_t height);
+
+  /**
+   * @brief Brings the terminal up to date with the game.
+   * @return The ANSI output to write, empty if nothing changed.
+   */
+  [[nodiscard]] std::string render();
+
+  /**
+   * @brief Gets the time played so far.
+   * @return The completion time once the game is finished, otherwise the time
+   * since the first selection, or zero before it.
+   */
+  [[nodiscard]] std::chrono::steady_clock::duration elapsed() const;
+
+  /**
+   * @brief Resumes the clock of a restored game.
+   * @param elapsed The time played before the game was saved.
+   */
+  void resume(std::chrono::steady_clock::duration elapsed);
+
+private:
+  /// The disk shown in each tower, by row from the top of the screen.
+  using Frame = std::vector<std::array<size_t, 3>>;
+
+  /**
+   * @brief Fits the game to the current terminal size.
+   * @return The size of a tower and the number of disks.
+   */
+  TowerLayout towerLayout() const;
+
+  /**
+   * @brief Lays the current state of the game out as a grid.
+   * @return The grid for the current terminal size.
+   */
+  Frame layout() const;
+
+  /**
+   * @brief Paints the whole screen.
+   * @param frame The grid to paint.
+   * @return The ANSI output of the repaint.
+   */
+  std::string repaint(const Frame &frame) const;
+
+  /**
+   * @brief Paints one cell, covering the columns of both disks.
+   * @param row The row of the cell, from the top of the screen.
+   * @param tower The tower of the cell.
+   * @param before The disk painted in the cell before, or 0.
+   * @param after The disk to paint in the cell, or 0.
+   * @return The ANSI output of the update.
+   */
+  std::string paintCell(size_t row, size_t tower, size_t before,
+                        size_t after) const;
+
+  /**
+   * @brief Paints the legend on the last row.
+   * @return The ANSI output of the legend.
+   */
+  std::string paintLegend() const;
+
+  /**
+   * @brief Starts or stops the clock of the game.
+   * @return true if the game has just been finished.
+   */
+  bool updateCompletionTime();
+
+private:
+  const toh::GameBoard &m_game; ///< A reference to the game being rendered.
+  size_t m_width;               ///< The number of columns of the terminal.
+  size_t m_height;              ///< The number of rows of the terminal.
+  Frame m_frame{};              ///< The grid painted last.
+  size_t m_disks{0};            ///< The number of disks painted last.
+  bool m_repaint{true};         ///< Whether the next frame is a full repaint.
+  bool m_finished{false};       ///< Whether the legend shows the time.
+  std::chrono::steady_clock::time_point
+      m_startTime{}; ///< The time of the first selection.
+  std::chrono::steady_clock::duration
+      m_completionDuration{}; ///< The time taken to complete the game.
+};
+
+/**
+ * @brief Plays a game on the controlling terminal with a DiffRenderer.
+ *
+ * Keys are read from stdin in raw mode and passed to a BasicGameController,
+ * and each frame is written to stdout with a single write. The screen is
+ * repainted in full whenever the terminal is resized. Only available on
+ * POSIX systems.
+ *
+ * @tparam GameType The game to play, a BasicGame of any rule policy.
+ * @param game A reference to the game to play.
+ * @param elapsed The time played before; receives the time played when the
+ * player quits.
+ * @return 0 once the player quits, 1 if stdin is not a terminal.
+ */
+template <typename GameType>
+int runDiffTerminal(GameType &game,
+                    std::chrono::steady_clock::duration &elapsed);
+
+extern template int runDiffTerminal(toh::Game &,
+                                    std::chrono::steady_clock::duration &);
+extern template int runDiffTerminal(toh::CyclicGame &,
+                                    std::chrono::steady_clock::duration &);
+extern template int runDiffTerminal(toh::AdjacentGame &,
+                                    std::chrono::steady_clock::duration &);
+extern template int runDiffTerminal(toh::BicolorGame &,
+                                    std::chrono::steady_clock::duration &);
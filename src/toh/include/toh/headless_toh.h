@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cctype>
+#include <chrono>
+#include <istream>
+#include <limits>
+
+#include "ftxui/component/screen_interactive.hpp"
+#include <ftxui/component/component.hpp>
+#include <ftxui/screen/screen.hpp>
+
+#include "libtoh/toh_model.h"
+#include "toh/terminal_toh.h"
+
+/**
+ * @struct HeadlessReport
+ * @brief Summary of a scripted headless session.
+ */
+struct HeadlessReport {
+  size_t events{};  ///< The number of key events read from the script.
+  size_t handled{}; ///< The number of events consumed by the controller.
+  std::chrono::steady_clock::duration elapsed{}; ///< Wall time of the run.
+};
+
+/**
+ * @class BasicHeadlessSession
+ * @brief Drives a game from a key script without a terminal.
+ *
+ * @tparam GameType The game to drive, a BasicGame of any rule policy.
+ *
+ * The session wires a GameViewer and a GameController exactly like the
+ * interactive executable does, but instead of looping on a real terminal it
+ * reads key events from a stream and dispatches them through the component
+ * tree. After each event the view is optionally rendered into an off-screen
+ * buffer, so the complete controller and viewer path can be exercised in
+ * pipelines that have no TTY.
+ *
+ * A script is a sequence of key characters. Whitespace is ignored and `#`
+ * starts a comment that runs to the end of the line. Reading stops at the end
+ * of the stream or after the quit key (`q`) has been dispatched.
+ *
+ * ### Example
+ * ```cpp
+ * #include <sstream>
+ *
+ * #include "libtoh/toh_model.h"
+ * #include "toh/headless_toh.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   Game game{1};
+ *   HeadlessSession session{game};
+ *
+ *   istringstream script{"a d q"};
+ *   auto report{session.run(script)};
+ *
+ *   cout << formatHeadlessReport(game, report) << endl;
+ *   return game.isFinished() ? 0 : 1;
+ * }
+ * ```
+ */
+template <typename GameType> class BasicHeadlessSession {
+public:
+  /**
+   * @brief Constructs a BasicHeadlessSession for the given game.
+   * @param game A reference to the game to drive.
+   * @param render Whether to render into the off-screen buffer after each
+   * event.
+   * @param width The width of the off-screen buffer.
+   * @param height The height of the off-screen buffer.
+   */
+  explicit BasicHeadlessSession(GameType &game, bool render = true,
+                                int width = 80, int height = 24);
+
+  /**
+   * @brief Deleted copy constructor.
+   *
+   * The viewer and controller hold references into the session.
+   * @param src The source BasicHeadlessSession object (unused).
+   */
+  BasicHeadlessSession(const BasicHeadlessSession &src) = delete;
+
+  /**
+   * @brief Deleted move constructor.
+   *
+   * @param src The source BasicHeadlessSession object (unused).
+   */
+  BasicHeadlessSession(BasicHeadlessSession &&src) noexcept = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @param src The source BasicHeadlessSession object (unused).
+   * @return Deleted.
+   */
+  BasicHeadlessSession &
+  operator=(const BasicHeadlessSession &src) = delete;
+
+  /**
+   * @brief Deleted move assignment operator.
+   *
+   * @param src The source BasicHeadlessSession object (unused).
+   * @return Deleted.
+   */
+  BasicHeadlessSession &
+  operator=(BasicHeadlessSession &&src) noexcept = delete;
+
+  /**
+   * @brief Feeds every key of the script through the controller.
+   * @param script The stream to read key events from.
+   * @return A report with the number of events and the elapsed time.
+   */
+  HeadlessReport run(std::istream &script) &;
+
+  /**
+   * @brief Returns the off-screen buffer holding the last rendered frame.
+   * @return A constant reference to the off-screen buffer.
+   */
+  const ftxui::Screen &canvas() const;
+
+private:
+  /**
+   * @brief Reads the next key event from the script.
+   *
+   * @param script The stream to read from.
+   * @param key Receives the key character.
+   * @return True if a key was read, false at the end of the stream.
+   */
+  static bool nextKey(std::istream &script, char &key);
+
+private:
+  ftxui::ScreenInteractive
+      m_screen; ///< Never installed; only satisfies the controller.
+  ftxui::Screen m_canvas;       ///< Off-screen buffer frames are rendered into.
+  GameViewer m_viewer; ///< The viewer of the driven game.
+  BasicGameController<GameType>
+      m_controller;             ///< The controller of the driven game.
+  ftxui::Component m_component; ///< The viewer with the controller attached.
+  bool m_render;                ///< Whether frames are rendered.
+};
+
+extern template class BasicHeadlessSession<toh::Game>;
+extern template class BasicHeadlessSession<toh::CyclicGame>;
+extern template class BasicHeadlessSession<toh::AdjacentGame>;
+extern template class BasicHeadlessSession<toh::BicolorGame>;
+
+/// The headless session of the classic game.
+using HeadlessSession = BasicHeadlessSession<toh::Game>;
+
+/**
+ * @brief Formats the final state of a game and the timing of a session.
+ * @param game The game after the session.
+ * @param report The report returned by BasicHeadlessSession::run.
+ * @return A multi-line, human-readable summary.
+ */
+std::string formatHeadlessReport(const toh::GameBoard &game,
+                                 const HeadlessReport &report);
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "libtoh/game_snapshot.h"
+#include "libtoh/seqlock.h"
+
+/**
+ * @struct SpectateSegment
+ * @brief The layout of the shared-memory segment a game is published in.
+ *
+ * The segment holds no pointers, so it reads the same in every process that
+ * maps it. The state is a toh::SeqLock, whose words are lock-free atomics and
+ * can be read from a read-only mapping: spectators never write to the
+ * segment, so any number of them add no work to the player.
+ */
+struct SpectateSegment {
+  static constexpr uint32_t Magic{0x50484F54}; ///< `TOHP` in little endian.
+  static constexpr uint32_t Version{2};        ///< The layout version.
+
+  std::atomic<uint32_t> magic{0};   ///< Magic, written once the rest is set.
+  uint32_t version{Version};        ///< The layout version.
+  std::atomic<uint32_t> closed{0};  ///< Set when the player exits.
+  int32_t owner{0};                 ///< The process id of the player.
+  toh::SeqLock<toh::GameSnapshot> state{}; ///< The published game.
+};
+
+/**
+ * @brief Gets the POSIX shared-memory name of a spectate session.
+ * @param name The session name given on the command line.
+ * @return The name of the segment, `/toh-<name>`.
+ */
+[[nodiscard]] std::string spectateSegmentName(const std::string &name);
+
+/**
+ * @class SpectatePublisher
+ * @brief Creates a spectate segment and publishes a game into it.
+ *
+ * publish() stores a snapshot without any system call or lock, so the
+ * player's input handling does not depend on how many spectators there are.
+ * The segment is marked closed when the publisher is destroyed, and unlinked
+ * unless another player has taken the name over since.
+ *
+ * ### Example
+ * ```cpp
+ * #include "toh/spectate.h"
+ *
+ * using namespace std;
+ * using namespace toh;
+ *
+ * int main() {
+ *   auto publisher{SpectatePublisher::create("demo")};
+ *   Game game{3};
+ *   game.select(Left);
+ *   if (publisher)
+ *     publisher->publish(game); // `toh --spectate demo` shows the selection
+ * }
+ * ```
+ */
+class SpectatePublisher {
+public:
+  /**
+   * @brief Creates and maps a segment.
+   *
+   * A segment left by a player that exited or crashed is replaced; one whose
+   * player is still running is left alone.
+   *
+   * @param name The session name.
+   * @return The publisher, or nullptr if shared memory is unavailable or a
+   * running player already publishes under that name.
+   */
+  static std::unique_ptr<SpectatePublisher> create(const std::string &name);
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source SpectatePublisher object (unused).
+   */
+  SpectatePublisher(const SpectatePublisher &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source SpectatePublisher object (unused).
+   * @return Deleted.
+   */
+  SpectatePublisher &operator=(const SpectatePublisher &src) = delete;
+
+  /**
+   * @brief Marks the segment closed, unmaps it and unlinks it if the name
+   * still refers to it.
+   */
+  ~SpectatePublisher();
+
+  /**
+   * @brief Publishes the state of a game.
+   * @param game The game, with at most toh::MaxSnapshotDisks disks.
+   */
+  void publish(const toh::GameBoard &game);
+
+private:
+  /**
+   * @brief Takes ownership of a mapped segment.
+   * @param name The name of the segment.
+   * @param segment The mapped, constructed segment.
+   * @param inode The inode of the segment, which identifies it under its
+   * name.
+   */
+  SpectatePublisher(std::string name, SpectateSegment *segment,
+                    uint64_t inode);
+
+private:
+  std::string m_name;          ///< The name of the segment.
+  SpectateSegment *m_segment;  ///< The mapped segment.
+  uint64_t m_inode;            ///< The inode of the segment.
+  uint64_t m_moves{0};         ///< Moves seen so far.
+  toh::GameSnapshot m_last{};  ///< The last published state.
+};
+
+/**
+ * @class SpectateView
+ * @brief Maps a spectate segment read-only and reads the published game.
+ */
+class SpectateView {
+public:
+  /**
+   * @brief Maps the segment of a session.
+   * @param name The session name.
+   * @return The view, or nullptr if no player publishes under that name.
+   */
+  static std::unique_ptr<SpectateView> open(const std::string &name);
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source SpectateView object (unused).
+   */
+  SpectateView(const SpectateView &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source SpectateView object (unused).
+   * @return Deleted.
+   */
+  SpectateView &operator=(const SpectateView &src) = delete;
+
+  /**
+   * @brief Unmaps the segment.
+   */
+  ~SpectateView();
+
+  /**
+   * @brief Reads the published game.
+   * @return The last published snapshot.
+   */
+  [[nodiscard]] toh::GameSnapshot snapshot() const;
+
+  /**
+   * @brief Gets the number of snapshots published so far.
+   * @return A counter that changes whenever the game does.
+   */
+  [[nodiscard]] uint64_t version() const;
+
+  /**
+   * @brief Checks whether the player has exited.
+   * @return true once the publisher is gone.
+   */
+  [[nodiscard]] bool isClosed() const;
+
+private:
+  /**
+   * @brief Takes ownership of a mapped segment.
+   * @param segment The mapped segment.
+   */
+  explicit SpectateView(const SpectateSegment *segment);
+
+private:
+  const SpectateSegment *m_segment; ///< The read-only mapping.
+};
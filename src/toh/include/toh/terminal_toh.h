@@ -9,6 +9,7 @@
 #include <ftxui/screen/screen.hpp>
 
 #include "libtoh/toh_model.h"
+#include "toh/tower_layout.h"
 
 /**
  * @class GameViewer
@@ -48,9 +49,9 @@ class GameViewer {
 public:
   /**
    * @brief Constructs a GameViewer object.
-   * @param game A reference to a Game instance to be viewed.
+   * @param game A reference to the game to be viewed, of any variant.
    */
-  explicit GameViewer(const toh::Game &game);
+  explicit GameViewer(const toh::GameBoard &game);
 
   /**
    * @brief Default copy constructor.
@@ -98,13 +99,33 @@ public:
    */
   ftxui::Component createView() const && = delete;
 
+  /**
+   * @brief Gets the time played so far.
+   * @return The completion time once the game is finished, otherwise the time
+   * since the first selection, or zero before it.
+   */
+  std::chrono::steady_clock::duration elapsed() const;
+
+  /**
+   * @brief Checks whether the clock on the legend is running.
+   * @return true from the first selection until the game is finished.
+   */
+  [[nodiscard]] bool isClockRunning() const;
+
+  /**
+   * @brief Resumes the clock of a restored game.
+   * @param elapsed The time played before the game was saved.
+   */
+  void resume(std::chrono::steady_clock::duration elapsed);
+
 private:
   /**
    * @brief Creates the legend component for the UI.
    *
    * @details The legend displays useful information such as the elapsed time
    * and a help for the control keys, providing context and guidance to the
-   * user during gameplay.
+   * user during gameplay. While the clock is running, the elapsed time is
+   * shown as of the last render; a Ticker can keep it moving.
    *
    * @return The FTXUI element representing the top bar.
    */
@@ -120,10 +141,11 @@ private:
    * @brief Creates the visual representation of a single tower.
    * @param tower The vector representing the disks on the tower.
    * @param is_selected Whether the tower is currently selected.
+   * @param disks The number of disks of the game, which scales the widths.
    * @return The FTXUI element representing the tower.
    */
   ftxui::Element createTower(const std::vector<size_t> &tower,
-                             bool is_selected) const;
+                             bool is_selected, size_t disks) const;
 
   /**
    * @brief Resets the completion time if the number of disks has changed or
@@ -144,7 +166,7 @@ private:
   std::string formatCompletionDuration() const;
 
 private:
-  const toh::Game &m_game; ///< A reference to the Game instance being viewed.
+  const toh::GameBoard &m_game; ///< A reference to the game being viewed.
   mutable std::chrono::steady_clock::time_point
       m_startTime{}; ///< The start time of the game session.
   mutable std::chrono::steady_clock::duration
@@ -153,9 +175,11 @@ private:
 };
 
 /**
- * @class GameController
+ * @class BasicGameController
  * @brief Handles user input and updates the game state.
  *
+ * @tparam GameType The game to control, a BasicGame of any rule policy.
+ *
  * ### Example
  * ```cpp
  * #include "ftxui/component/screen_interactive.hpp"
@@ -180,47 +204,48 @@ private:
  * }
  * ```
  */
-class GameController {
+template <typename GameType> class BasicGameController {
 public:
   /**
-   * @brief Constructs a GameController with the specified game and screen.
+   * @brief Constructs a BasicGameController with the specified game and screen.
    * @param game A reference to the game to control.
    * @param screen A reference to the FTXUI screen for rendering.
    */
-  explicit GameController(toh::Game &game, ftxui::ScreenInteractive &screen);
+  explicit BasicGameController(GameType &game,
+                               ftxui::ScreenInteractive &screen);
 
   /**
    * @brief Default copy constructor.
    *
-   * @param src The source GameController object to copy from.
+   * @param src The source BasicGameController object to copy from.
    */
-  GameController(const GameController &src) = default;
+  BasicGameController(const BasicGameController &src) = default;
 
   /**
    * @brief Default move constructor.
    *
-   * @param src The source GameController object to move from.
+   * @param src The source BasicGameController object to move from.
    * @note This operation is noexcept.
    */
-  GameController(GameController &&src) noexcept = default;
+  BasicGameController(BasicGameController &&src) noexcept = default;
 
   /**
    * @brief Deleted copy assignment operator.
    *
-   * Copy assignment is disabled for GameController.
-   * @param src The source GameController object (unused).
+   * Copy assignment is disabled for BasicGameController.
+   * @param src The source BasicGameController object (unused).
    * @return Deleted.
    */
-  GameController &operator=(const GameController &src) = delete;
+  BasicGameController &operator=(const BasicGameController &src) = delete;
 
   /**
    * @brief Deleted move assignment operator.
    *
-   * Move assignment is disabled for GameController.
-   * @param src The source GameController object (unused).
+   * Move assignment is disabled for BasicGameController.
+   * @param src The source BasicGameController object (unused).
    * @return Deleted.
    */
-  GameController &operator=(GameController &&src) noexcept = delete;
+  BasicGameController &operator=(BasicGameController &&src) noexcept = delete;
 
   /**
    * @brief Processes user input events and updates the game.
@@ -260,7 +285,15 @@ private:
   void modifyGameSize(int delta);
 
 private:
-  toh::Game &m_game; ///< Reference to the game being controlled.
+  GameType &m_game; ///< Reference to the game being controlled.
   ftxui::ScreenInteractive
       &m_screen; ///< Reference to the FTXUI screen for rendering.
 };
+
+extern template class BasicGameController<toh::Game>;
+extern template class BasicGameController<toh::CyclicGame>;
+extern template class BasicGameController<toh::AdjacentGame>;
+extern template class BasicGameController<toh::BicolorGame>;
+
+/// The controller of the classic game.
+using GameController = BasicGameController<toh::Game>;
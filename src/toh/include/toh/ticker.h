@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class Ticker
+ * @brief Calls a function periodically from a dedicated thread, but only while
+ * it is running.
+ *
+ * While stopped, the thread blocks on a condition variable with no timeout,
+ * so it never wakes up and costs no CPU. While running, it sleeps until the
+ * next tick, calls the function and sleeps again. Ticks missed while the
+ * function or the system was slow are skipped instead of being replayed in a
+ * burst.
+ *
+ * The function is called without any lock held, so it may call setRunning().
+ *
+ * ### Example
+ * ```cpp
+ * #include "ftxui/component/screen_interactive.hpp"
+ * #include "toh/ticker.h"
+ *
+ * using namespace std;
+ * using namespace ftxui;
+ *
+ * int main() {
+ *   auto screen{ScreenInteractive::Fullscreen()};
+ *   Ticker ticker{[&] { screen.PostEvent(Event::Custom); },
+ *                 chrono::milliseconds{100}};
+ *   ticker.setRunning(true); // Redraw ten times a second
+ * }
+ * ```
+ */
+class Ticker {
+public:
+  /**
+   * @brief Starts the ticker thread, stopped.
+   * @param tick The function to call on every tick.
+   * @param period The time between two ticks; must be positive.
+   */
+  explicit Ticker(std::function<void()> tick,
+                  std::chrono::steady_clock::duration period);
+
+  /**
+   * @brief Deleted copy constructor.
+   *
+   * The thread refers to the ticker.
+   * @param src The source Ticker object (unused).
+   */
+  Ticker(const Ticker &src) = delete;
+
+  /**
+   * @brief Deleted move constructor.
+   *
+   * @param src The source Ticker object (unused).
+   */
+  Ticker(Ticker &&src) noexcept = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   *
+   * @param src The source Ticker object (unused).
+   * @return Deleted.
+   */
+  Ticker &operator=(const Ticker &src) = delete;
+
+  /**
+   * @brief Deleted move assignment operator.
+   *
+   * @param src The source Ticker object (unused).
+   * @return Deleted.
+   */
+  Ticker &operator=(Ticker &&src) noexcept = delete;
+
+  /**
+   * @brief Stops the thread and waits for it to finish.
+   */
+  ~Ticker();
+
+  /**
+   * @brief Starts or stops ticking.
+   *
+   * The first tick after starting comes one period later. Setting the
+   * current state again does nothing and does not wake the thread.
+   * @param running Whether to tick.
+   */
+  void setRunning(bool running);
+
+  /**
+   * @brief Checks whether the ticker is running.
+   * @return true if the ticker is ticking.
+   */
+  [[nodiscard]] bool isRunning() const;
+
+private:
+  /**
+   * @brief The body of the ticker thread.
+   */
+  void loop();
+
+private:
+  std::function<void()> m_tick; ///< The function to call on every tick.
+  std::chrono::steady_clock::duration m_period; ///< The time between ticks.
+  mutable std::mutex m_lock;           ///< Guards the two flags below.
+  std::condition_variable m_wake;      ///< Wakes the thread on a change.
+  bool m_running{false};               ///< Whether to tick.
+  bool m_stopping{false};              ///< Whether the thread must exit.
+  std::thread m_thread;                ///< The ticker thread, started last.
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "libtoh/game_snapshot.h"
+
+/**
+ * @brief The largest number of disks the front ends play with; every game
+ * can be published as a toh::GameSnapshot.
+ */
+inline constexpr size_t MaxDisk{toh::MaxSnapshotDisks};
+
+/**
+ * @struct TowerLayout
+ * @brief Fits towers of any number of disks into a fixed number of cells.
+ *
+ * Both front ends draw disks centred in a column, as rows of cells on either
+ * side of the centre. While every disk fits, disk `i` spans `i` cells on each
+ * side and each disk has its own row, as it always has. Past that, widths are
+ * scaled down to the column and a tower taller than the column is drawn as
+ * one band per row but the top one, each showing its largest disk, except
+ * the last band, which shows the top disk of the tower. The top row is left
+ * free for the selected tower to lift that disk to. Both take time bounded by
+ * the number of rows, whatever the number of disks.
+ */
+struct TowerLayout {
+  size_t disks{0};   ///< The number of disks of the game.
+  size_t columns{0}; ///< The width of a tower, in cells.
+  size_t rows{0};    ///< The height of a tower, in cells.
+
+  /**
+   * @brief Gets the number of cells a disk spans on each side of the centre.
+   * @param disk The disk, from 1 to `disks`, or 0 for none.
+   * @return The half width, at least 1 for a disk if the column has room for
+   * any.
+   */
+  [[nodiscard]] size_t halfWidth(size_t disk) const;
+
+  /**
+   * @brief Gets the disks drawn on each row of a tower.
+   * @param tower The disks of the tower, from the bottom up.
+   * @return The whole tower if it fits, else `rows - 1` disks ending with
+   * the top one, from the bottom up.
+   */
+  [[nodiscard]] std::vector<size_t>
+  visibleRows(const std::vector<size_t> &tower) const;
+};
@@ -1,20 +1,372 @@
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+
 #include "ftxui/component/screen_interactive.hpp"
+#include "libtoh/metrics.h"
+#include "libtoh/save_state.h"
 #include "libtoh/toh_model.h"
+#include "libtoh/trace.h"
+#include "toh/auto_solver.h"
+#include "toh/diff_toh.h"
+#include "toh/headless_toh.h"
+#include "toh/spectate.h"
 #include "toh/terminal_toh.h"
+#include "toh/ticker.h"
 
 using namespace std;
+using namespace chrono;
 using namespace ftxui;
 using namespace toh;
 
-int main() {
+namespace {
+constexpr string_view Usage{
+    "usage: toh [--variant NAME] [--headless [--script FILE|-] [--no-render]]\n"
+    "           [--diff] [--save FILE|--no-save] [--tick MS] [--trace FILE]\n"
+    "           [--auto-solve MS] [--publish NAME|--spectate NAME]\n"
+    "           [--metrics-file FILE]\n"
+    "  --variant    rules to play by: classic (default), cyclic, adjacent or\n"
+    "               bicolor\n"
+    "  --diff       repaint only the rows that change, for slow terminals\n"
+    "  --save       resume from and save to FILE (default ~/.toh-VARIANT.sav)\n"
+    "  --no-save    start a new game and do not save it on exit\n"
+    "  --tick       refresh period of the running clock, 0 for none\n"
+    "               (default 100)\n"
+    "  --headless   feed key events from a script instead of a terminal\n"
+    "  --script     file to read key events from, '-' for stdin (default)\n"
+    "  --no-render  skip rendering frames into the off-screen buffer\n"
+    "  --trace      write Chrome trace events to FILE on exit\n"
+    "  --auto-solve watch a solver play a new game of the saved size, one\n"
+    "               selection every MS\n"
+    "  --publish    share the game in memory for spectators to watch, only\n"
+    "               when playing in the full screen terminal\n"
+    "  --spectate   watch the game published under NAME, read-only\n"
+    "  --metrics-file\n"
+    "               rewrite FILE every second with Prometheus metrics\n"};
+
+struct Options {
+  string_view variant{ClassicRule::Name};
+  bool headless{false};
+  bool diff{false};
+  optional<string> save{};
+  size_t tick{100};
+  optional<size_t> autoSolve{};
+  string publish{};
+  string spectate{};
+  string script{"-"};
+  bool render{true};
+  string trace{};
+  string metricsFile{};
+};
+
+constexpr seconds MetricsPeriod{1};
+// Spectators poll the shared segment at the clock tick, but never busy wait
+// on it, even when the clock does not tick at all.
+constexpr milliseconds SpectateFastestPoll{10};
+constexpr milliseconds SpectateDefaultPoll{100};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 1) {
+    string_view arg{argv[i]};
+    if (arg == "--variant" && i + 1 < argc) {
+      options.variant = argv[++i];
+    } else if (arg == "--headless") {
+      options.headless = true;
+    } else if (arg == "--diff") {
+      options.diff = true;
+    } else if (arg == "--save" && i + 1 < argc) {
+      options.save = argv[++i];
+    } else if (arg == "--no-save") {
+      options.save = "";
+    } else if (arg == "--tick" && i + 1 < argc) {
+      try {
+        options.tick = stoul(argv[++i]);
+      } catch (const logic_error &) {
+        return nullopt;
+      }
+    } else if (arg == "--auto-solve" && i + 1 < argc) {
+      try {
+        options.autoSolve = stoul(argv[++i]);
+      } catch (const logic_error &) {
+        return nullopt;
+      }
+    } else if (arg == "--publish" && i + 1 < argc) {
+      options.publish = argv[++i];
+    } else if (arg == "--spectate" && i + 1 < argc) {
+      options.spectate = argv[++i];
+    } else if (arg == "--script" && i + 1 < argc) {
+      options.script = argv[++i];
+    } else if (arg == "--no-render") {
+      options.render = false;
+    } else if (arg == "--trace" && i + 1 < argc) {
+      options.trace = argv[++i];
+    } else if (arg == "--metrics-file" && i + 1 < argc) {
+      options.metricsFile = argv[++i];
+    } else {
+      return nullopt;
+    }
+  }
+  // Only the full screen game publishes its moves.
+  if (!options.publish.empty() &&
+      (options.headless || options.diff || options.autoSolve ||
+       !options.spectate.empty()))
+    return nullopt;
+  return options;
+}
+
+string savePath(const Options &options) {
+  if (options.save)
+    return *options.save;
+#if defined(_WIN32)
+  auto home{getenv("USERPROFILE")};
+#else
+  auto home{getenv("HOME")};
+#endif
+  return format("{}/.toh-{}.sav", home ? home : ".", options.variant);
+}
+
+// Resumes the saved game, unless it is missing, invalid or already finished.
+template <typename GameType> SaveState<GameType> loadGame(const string &path) {
+  if (!path.empty()) {
+    auto state{deserialize<GameType>(loadFromFile(path))};
+    if (state && !state->game.isFinished())
+      return *std::move(state);
+  }
+  return {GameType{3}, milliseconds{}};
+}
+
+template <typename GameType>
+void saveGame(const string &path, const GameType &game,
+              steady_clock::duration elapsed) {
+  if (path.empty())
+    return;
+  auto bytes{serialize(game, duration_cast<milliseconds>(elapsed))};
+  if (!saveToFile(path, bytes))
+    cerr << format("toh: cannot save the game to '{}'", path) << endl;
+}
+
+template <typename GameType> int runHeadless(const Options &options) {
+  ifstream file{};
+  if (options.script != "-") {
+    file.open(options.script);
+    if (!file) {
+      cerr << format("toh: cannot open script '{}'", options.script) << endl;
+      return 1;
+    }
+  }
+  istream &script{options.script == "-" ? cin : file};
+
+  GameType game{3};
+  BasicHeadlessSession<GameType> session{game, options.render};
+  auto report{session.run(script)};
+
+  cout << formatHeadlessReport(game, report) << endl;
+  return 0;
+}
+
+template <typename GameType> int runInteractive(const Options &options) {
   auto screen{ScreenInteractive::Fullscreen()};
 
-  Game game{3};
+  auto path{savePath(options)};
+  auto [game, elapsed]{loadGame<GameType>(path)};
   GameViewer viewer{game};
-  GameController controller{game, screen};
+  BasicGameController<GameType> controller{game, screen};
+  viewer.resume(elapsed);
+
+  auto view{viewer.createView()};
+  view |= CatchEvent(controller);
+
+  // The ticker only wakes the screen while the clock on the legend runs, so
+  // an idle game sleeps until the next key.
+  optional<Ticker> ticker{};
+  if (options.tick > 0)
+    ticker.emplace([&] { screen.PostEvent(Event::Custom); },
+                   milliseconds{options.tick});
+  // Publishing from the renderer costs a snapshot per frame, and a frame
+  // follows every event the controller handles.
+  unique_ptr<SpectatePublisher> publisher{};
+  if (!options.publish.empty()) {
+    publisher = SpectatePublisher::create(options.publish);
+    if (!publisher) {
+      cerr << format("toh: cannot publish the game as '{}', is it already "
+                     "published?",
+                     options.publish)
+           << endl;
+      return 1;
+    }
+  }
+  auto component{Renderer(view, [&] {
+    auto element{view->Render()};
+    if (ticker)
+      ticker->setRunning(viewer.isClockRunning());
+    if (publisher)
+      publisher->publish(game);
+    return element;
+  })};
+
+  screen.Loop(component);
+  saveGame(path, game, viewer.elapsed());
+  return 0;
+}
+
+// The solver plays on a worker thread; the screen renders whatever state it
+// last published, so neither ever waits for the other.
+template <typename GameType> int runAutoSolve(const Options &options) {
+  auto screen{ScreenInteractive::Fullscreen()};
+
+  auto [game, elapsed]{loadGame<GameType>(savePath(options))};
+  size_t disks{};
+  for (auto &&position : {Left, Middle, Right})
+    disks += game.getTower(position).size();
+  disks = min(disks, MaxSnapshotDisks);
+
+  GameBoard board{disks};
+  GameViewer viewer{board};
+  BasicAutoSolver<GameType> solver{disks, milliseconds{*options.autoSolve},
+                                   [&] { screen.PostEvent(Event::Custom); }};
 
-  auto component{viewer.createView()};
-  component |= CatchEvent(controller);
+  auto view{viewer.createView()};
+  auto component{Renderer(view, [&] {
+    board = solver.snapshot().board();
+    return view->Render();
+  })};
+  component |= CatchEvent([&](Event event) {
+    if (event != Event::Character('q'))
+      return false;
+    screen.Exit();
+    return true;
+  });
 
   screen.Loop(component);
+  return 0;
+}
+
+// Spectators only read the shared segment; a ticker polls its version and
+// wakes the screen when the player has moved or gone.
+int runSpectator(const Options &options) {
+  auto view{SpectateView::open(options.spectate)};
+  if (!view) {
+    cerr << format("toh: no game is published as '{}'", options.spectate)
+         << endl;
+    return 1;
+  }
+  auto screen{ScreenInteractive::Fullscreen()};
+
+  GameBoard board{view->snapshot().board()};
+  GameViewer viewer{board};
+  auto seen{view->version()};
+  auto poll{options.tick == 0
+                ? SpectateDefaultPoll
+                : max(milliseconds{options.tick}, SpectateFastestPoll)};
+  Ticker ticker{[&] {
+                  if (view->isClosed()) {
+                    screen.Exit();
+                  } else if (auto version{view->version()}; version != seen) {
+                    seen = version;
+                    screen.PostEvent(Event::Custom);
+                  }
+                },
+                poll};
+  ticker.setRunning(true);
+
+  auto spectated{viewer.createView()};
+  auto component{Renderer(spectated, [&] {
+    board = view->snapshot().board();
+    return spectated->Render();
+  })};
+  component |= CatchEvent([&](Event event) {
+    if (event != Event::Character('q'))
+      return false;
+    screen.Exit();
+    return true;
+  });
+
+  screen.Loop(component);
+  return 0;
+}
+
+template <typename GameType> int runDiff(const Options &options) {
+  auto path{savePath(options)};
+  auto [game, played]{loadGame<GameType>(path)};
+  steady_clock::duration elapsed{played};
+  if (runDiffTerminal(game, elapsed) != 0) {
+    cerr << "toh: --diff needs a POSIX terminal on stdin" << endl;
+    return 1;
+  }
+  saveGame(path, game, elapsed);
+  return 0;
+}
+
+template <typename GameType> int run(const Options &options) {
+  TOH_METRICS_SCOPE(ActiveSessions);
+  if (options.headless)
+    return runHeadless<GameType>(options);
+  if (options.autoSolve)
+    return runAutoSolve<GameType>(options);
+  return options.diff ? runDiff<GameType>(options)
+                      : runInteractive<GameType>(options);
+}
+
+// Every variant is a distinct type, so the choice is made once here and the
+// game loop runs without any dispatch on the rules.
+optional<int> runVariant(const Options &options) {
+  if (!options.spectate.empty())
+    return runSpectator(options);
+  if (options.variant == ClassicRule::Name)
+    return run<Game>(options);
+  if (options.variant == CyclicRule::Name)
+    return run<CyclicGame>(options);
+  if (options.variant == AdjacentRule::Name)
+    return run<AdjacentGame>(options);
+  if (options.variant == BicolorRule::Name)
+    return run<BicolorGame>(options);
+  return nullopt;
+}
+
+void writeTrace(const string &path) {
+  ofstream file{path};
+  if (!file) {
+    cerr << format("toh: cannot write trace '{}'", path) << endl;
+    return;
+  }
+  if (!trace::isEnabled())
+    cerr << "toh: tracing is compiled out, configure with -DTOH_TRACING=ON"
+         << endl;
+  trace::writeChromeTrace(file);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  // Rewrites the metrics from its own thread, so scrapers see a live game.
+  optional<Ticker> exporter{};
+  if (!options->metricsFile.empty()) {
+    if (!metrics::isEnabled())
+      cerr << "toh: metrics are compiled out, configure with -DTOH_METRICS=ON"
+           << endl;
+    exporter.emplace(
+        [&] { metrics::writePrometheusFile(options->metricsFile); },
+        MetricsPeriod);
+    exporter->setRunning(true);
+  }
+
+  auto status{runVariant(*options)};
+  exporter.reset();
+  if (!options->metricsFile.empty() &&
+      !metrics::writePrometheusFile(options->metricsFile))
+    cerr << format("toh: cannot write metrics to '{}'", options->metricsFile)
+         << endl;
+  if (!status) {
+    cerr << Usage;
+    return 1;
+  }
+  if (!options->trace.empty())
+    writeTrace(options->trace);
+  return *status;
 }
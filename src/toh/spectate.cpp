@@ -0,0 +1,186 @@
+#include "toh/spectate.h"
+
+#include <new>
+#include <optional>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace toh;
+
+namespace {
+#if !defined(_WIN32)
+constexpr auto SegmentSize{sizeof(SpectateSegment)};
+
+// Maps a descriptor and closes it; the mapping outlives it.
+void *mapSegment(int descriptor, int protection) {
+  auto memory{mmap(nullptr, SegmentSize, protection, MAP_SHARED, descriptor,
+                   0)};
+  close(descriptor);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+
+// Gets the inode of the segment a name refers to, if any.
+optional<uint64_t> segmentInode(const string &path) {
+  auto descriptor{shm_open(path.c_str(), O_RDONLY, 0)};
+  if (descriptor < 0)
+    return nullopt;
+  struct stat status {};
+  auto found{fstat(descriptor, &status) == 0};
+  close(descriptor);
+  if (!found)
+    return nullopt;
+  return static_cast<uint64_t>(status.st_ino);
+}
+
+// Checks whether the player of a segment is gone: it exited and closed it, or
+// crashed and left it open. Segments that are still being created, or that
+// are not ours, are never taken over.
+bool isAbandoned(const string &path) {
+  auto descriptor{shm_open(path.c_str(), O_RDONLY, 0)};
+  if (descriptor < 0)
+    return errno == ENOENT;
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0 ||
+      static_cast<size_t>(status.st_size) < SegmentSize) {
+    close(descriptor);
+    return false;
+  }
+  auto memory{mapSegment(descriptor, PROT_READ)};
+  if (!memory)
+    return false;
+
+  auto segment{static_cast<const SpectateSegment *>(memory)};
+  auto abandoned{false};
+  if (segment->magic.load(memory_order_acquire) == SpectateSegment::Magic) {
+    // Older layouts have no owner but mark themselves closed all the same.
+    abandoned = segment->closed.load(memory_order_acquire) != 0 ||
+                (segment->version == SpectateSegment::Version &&
+                 kill(segment->owner, 0) != 0 && errno == ESRCH);
+  }
+  munmap(memory, SegmentSize);
+  return abandoned;
+}
+#endif
+} // namespace
+
+string spectateSegmentName(const string &name) { return "/toh-" + name; }
+
+unique_ptr<SpectatePublisher> SpectatePublisher::create(const string &name) {
+#if !defined(_WIN32)
+  auto path{spectateSegmentName(name)};
+  auto descriptor{shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)};
+  // A player that crashed leaves its segment behind; start from a new one
+  // rather than write into it, and never take over a game still played.
+  if (descriptor < 0 && errno == EEXIST && isAbandoned(path)) {
+    shm_unlink(path.c_str());
+    descriptor = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (descriptor < 0)
+    return nullptr;
+  struct stat status {};
+  if (ftruncate(descriptor, static_cast<off_t>(SegmentSize)) != 0 ||
+      fstat(descriptor, &status) != 0) {
+    close(descriptor);
+    shm_unlink(path.c_str());
+    return nullptr;
+  }
+  auto memory{mapSegment(descriptor, PROT_READ | PROT_WRITE)};
+  if (!memory) {
+    shm_unlink(path.c_str());
+    return nullptr;
+  }
+
+  auto segment{new (memory) SpectateSegment{}};
+  segment->owner = static_cast<int32_t>(getpid());
+  segment->magic.store(SpectateSegment::Magic, memory_order_release);
+  return unique_ptr<SpectatePublisher>{new SpectatePublisher{
+      std::move(path), segment, static_cast<uint64_t>(status.st_ino)}};
+#else
+  static_cast<void>(name);
+  return nullptr;
+#endif
+}
+
+SpectatePublisher::SpectatePublisher(string name, SpectateSegment *segment,
+                                     uint64_t inode)
+    : m_name{std::move(name)}, m_segment{segment}, m_inode{inode} {}
+
+SpectatePublisher::~SpectatePublisher() {
+#if !defined(_WIN32)
+  m_segment->closed.store(1, memory_order_release);
+  munmap(m_segment, SegmentSize);
+  // The name may have been taken over since, by a player that could not see
+  // this process; only remove the segment this publisher created.
+  if (segmentInode(m_name) == m_inode)
+    shm_unlink(m_name.c_str());
+#endif
+}
+
+void SpectatePublisher::publish(const GameBoard &game) {
+  auto snapshot{GameSnapshot::of(game)};
+  if (snapshot.disks() != m_last.disks())
+    m_moves = 0;
+  else if (snapshot.towers != m_last.towers)
+    m_moves += 1;
+  snapshot.moves = m_moves;
+  // Renders repeat the same state; skipping them keeps version() a count of
+  // changes, which is all spectators poll.
+  if (snapshot == m_last && m_segment->state.version() > 0)
+    return;
+  m_segment->state.store(snapshot);
+  m_last = snapshot;
+}
+
+unique_ptr<SpectateView> SpectateView::open(const string &name) {
+#if !defined(_WIN32)
+  auto path{spectateSegmentName(name)};
+  auto descriptor{shm_open(path.c_str(), O_RDONLY, 0)};
+  if (descriptor < 0)
+    return nullptr;
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0 ||
+      static_cast<size_t>(status.st_size) < SegmentSize) {
+    close(descriptor);
+    return nullptr;
+  }
+  auto memory{mapSegment(descriptor, PROT_READ)};
+  if (!memory)
+    return nullptr;
+
+  auto segment{static_cast<const SpectateSegment *>(memory)};
+  if (segment->magic.load(memory_order_acquire) != SpectateSegment::Magic ||
+      segment->version != SpectateSegment::Version) {
+    munmap(memory, SegmentSize);
+    return nullptr;
+  }
+  return unique_ptr<SpectateView>{new SpectateView{segment}};
+#else
+  static_cast<void>(name);
+  return nullptr;
+#endif
+}
+
+SpectateView::SpectateView(const SpectateSegment *segment)
+    : m_segment{segment} {}
+
+SpectateView::~SpectateView() {
+#if !defined(_WIN32)
+  munmap(const_cast<SpectateSegment *>(m_segment), SegmentSize);
+#endif
+}
+
+GameSnapshot SpectateView::snapshot() const { return m_segment->state.load(); }
+
+uint64_t SpectateView::version() const { return m_segment->state.version(); }
+
+bool SpectateView::isClosed() const {
+  return m_segment->closed.load(memory_order_acquire) != 0;
+}
@@ -1,20 +1,69 @@
 #include "toh/terminal_toh.h"
 
+#include "ftxui/dom/node.hpp"
+#include "libtoh/metrics.h"
+
 using namespace std;
 using namespace chrono;
 using namespace ftxui;
 using namespace toh;
 
 namespace {
-constexpr size_t MaxDisk{10};
-const map<size_t, Color> ColorMap{
-    {0, Color::Black},        {1, Color::YellowLight}, {2, Color::RedLight},
-    {3, Color::MagentaLight}, {4, Color::GreenLight},  {5, Color::CyanLight},
-    {6, Color::BlueLight},    {7, Color::GrayLight},   {8, Color::GrayDark},
-    {9, Color::SandyBrown},   {10, Color::Red}};
+// Disk colours repeat every ten disks.
+const array<Color, 10> Colors{
+    Color::Black,        Color::YellowLight, Color::RedLight,
+    Color::MagentaLight, Color::GreenLight,  Color::CyanLight,
+    Color::BlueLight,    Color::GrayLight,   Color::GrayDark,
+    Color::SandyBrown};
+
+/*
+ * Draws a tower straight into the cells it is given. Unlike a box of one
+ * element per disk, its size is known when it is drawn, so the disks are
+ * fitted to it with a TowerLayout and drawing never touches more disks than
+ * the tower has rows.
+ */
+class TowerNode : public Node {
+public:
+  TowerNode(const vector<size_t> &tower, bool selected, size_t disks)
+      : m_tower{tower}, m_selected{selected}, m_disks{disks} {}
+
+  void ComputeRequirement() override {
+    requirement_ = {};
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+  }
+
+  void Render(Screen &screen) override {
+    auto width{box_.x_max - box_.x_min + 1};
+    auto height{box_.y_max - box_.y_min + 1};
+    if (width <= 0 || height <= 0)
+      return;
+    TowerLayout layout{m_disks, static_cast<size_t>(width),
+                       static_cast<size_t>(height)};
+    auto rows{layout.visibleRows(m_tower)};
+    for (size_t row{0}; row < rows.size(); row += 1) {
+      auto y{box_.y_max - static_cast<int>(row)};
+      // A selected tower lifts its top disk to the top row.
+      if (m_selected && row + 1 == rows.size() && rows.size() < layout.rows)
+        y = box_.y_min;
+      auto span{static_cast<int>(layout.halfWidth(rows[row]) * 2)};
+      auto x{box_.x_min + (width - span) / 2};
+      for (auto end{x + span}; x < end; x += 1)
+        screen.PixelAt(x, y).background_color =
+            Colors[rows[row] % Colors.size()];
+    }
+  }
+
+private:
+  const vector<size_t> &m_tower;
+  bool m_selected;
+  size_t m_disks;
+};
 } // namespace
 
-GameViewer::GameViewer(const toh::Game &game) : m_game{game} {}
+GameViewer::GameViewer(const toh::GameBoard &game) : m_game{game} {}
 
 Component GameViewer::createView() const & {
   return Renderer([&] {
@@ -22,6 +71,27 @@ Component GameViewer::createView() const & {
   });
 }
 
+steady_clock::duration GameViewer::elapsed() const {
+  if (m_completionDuration.count())
+    return m_completionDuration;
+  if (m_startTime == steady_clock::time_point{})
+    return steady_clock::duration{};
+  return steady_clock::now() - m_startTime;
+}
+
+bool GameViewer::isClockRunning() const {
+  return m_startTime != steady_clock::time_point{} &&
+         m_completionDuration.count() == 0 && !m_game.isFinished();
+}
+
+void GameViewer::resume(steady_clock::duration elapsed) {
+  if (elapsed <= steady_clock::duration{})
+    return;
+  m_startTime = steady_clock::now() - elapsed;
+  if (m_game.isFinished())
+    m_completionDuration = elapsed;
+}
+
 Element GameViewer::createLegend() const {
   updateCompletionTime();
 
@@ -32,19 +102,28 @@ Element GameViewer::createLegend() const {
   string duration{};
   if (m_completionDuration.count() > 0) {
     duration = formatCompletionDuration();
+  } else if (isClockRunning()) {
+    duration = format("Elapsed {:.1f} (s)",
+                      duration_cast<milliseconds>(elapsed()).count() / 1000.0);
   }
 
   return hbox(text(help_text), filler(), text(duration));
 }
 
 Element GameViewer::createTowers() const {
+  TOH_TRACE_SCOPE("GameViewer::createTowers");
+  TOH_METRICS_INCREMENT(FramesRendered);
   resetCompletionTimeIfNeeded();
 
+  size_t disks{};
+  for (auto &&position : {Left, Middle, Right})
+    disks += m_game.getTower(position).size();
+
   vector<Element> towers{};
   for (auto &&position : {Left, Middle, Right}) {
-    towers.push_back(
-        createTower(m_game.getTower(position), m_game.isSelected(position)) |
-        flex | size(WIDTH, EQUAL, Terminal::Size().dimx));
+    towers.push_back(createTower(m_game.getTower(position),
+                                 m_game.isSelected(position), disks) |
+                     flex | size(WIDTH, EQUAL, Terminal::Size().dimx));
   }
 
   return hbox(towers[Left], separator(), towers[Middle], separator(),
@@ -52,16 +131,9 @@ Element GameViewer::createTowers() const {
 }
 
 Element GameViewer::createTower(const vector<size_t> &tower,
-                                bool is_selected) const {
-  vector<Element> disks{filler()};
-  for (auto it{crbegin(tower)}; it != crend(tower); advance(it, 1)) {
-    disks.push_back(text(std::string(*it * 2, ' ')) |
-                    bgcolor(ColorMap.at(*it % MaxDisk)) | center);
-    if (is_selected && disks.size() == 2) {
-      disks.push_back(filler());
-    }
-  }
-  return vbox(disks);
+                                bool is_selected, size_t disks) const {
+  TOH_TRACE_SCOPE("GameViewer::createTower");
+  return make_shared<TowerNode>(tower, is_selected, disks);
 }
 
 void GameViewer::resetCompletionTimeIfNeeded() const {
@@ -89,11 +161,15 @@ string GameViewer::formatCompletionDuration() const {
 
 // GameController Implementation
 
-GameController::GameController(toh::Game &game,
-                               ftxui::ScreenInteractive &screen)
+template <typename GameType>
+BasicGameController<GameType>::BasicGameController(
+    GameType &game, ftxui::ScreenInteractive &screen)
     : m_game{game}, m_screen{screen} {}
 
-bool GameController::operator()(ftxui::Event event) & {
+template <typename GameType>
+bool BasicGameController<GameType>::operator()(ftxui::Event event) & {
+  TOH_TRACE_SCOPE("GameController::operator()");
+  TOH_METRICS_INCREMENT(EventsHandled);
   if (handleMovement(event))
     return true;
   if (handleGameModification(event))
@@ -105,7 +181,8 @@ bool GameController::operator()(ftxui::Event event) & {
   return false;
 }
 
-bool GameController::handleMovement(ftxui::Event event) {
+template <typename GameType>
+bool BasicGameController<GameType>::handleMovement(ftxui::Event event) {
   if (event == Event::Character('a') || event == Event::Character('j')) {
     m_game.select(Left);
     return true;
@@ -121,7 +198,8 @@ bool GameController::handleMovement(ftxui::Event event) {
   return false;
 }
 
-bool GameController::handleGameModification(ftxui::Event event) {
+template <typename GameType>
+bool BasicGameController<GameType>::handleGameModification(ftxui::Event event) {
   if (event == Event::Character('+')) {
     modifyGameSize(1);
     return true;
@@ -133,12 +211,18 @@ bool GameController::handleGameModification(ftxui::Event event) {
   return false;
 }
 
-void GameController::modifyGameSize(int delta) {
+template <typename GameType>
+void BasicGameController<GameType>::modifyGameSize(int delta) {
   size_t size{};
   for (auto &&position : {Left, Middle, Right}) {
     size += m_game.getTower(position).size();
   }
 
   size = (delta > 0) ? min(size + 1, MaxDisk) : max(size - 1, size_t{1});
-  m_game = Game{size};
+  m_game = GameType{size};
 }
+
+template class BasicGameController<Game>;
+template class BasicGameController<CyclicGame>;
+template class BasicGameController<AdjacentGame>;
+template class BasicGameController<BicolorGame>;
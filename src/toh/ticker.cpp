@@ -0,0 +1,53 @@
+#include "toh/ticker.h"
+
+using namespace std;
+using namespace chrono;
+
+Ticker::Ticker(function<void()> tick, steady_clock::duration period)
+    : m_tick{std::move(tick)}, m_period{period},
+      m_thread{[this] { loop(); }} {}
+
+Ticker::~Ticker() {
+  {
+    lock_guard guard{m_lock};
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+void Ticker::setRunning(bool running) {
+  {
+    lock_guard guard{m_lock};
+    if (m_running == running)
+      return;
+    m_running = running;
+  }
+  m_wake.notify_one();
+}
+
+bool Ticker::isRunning() const {
+  lock_guard guard{m_lock};
+  return m_running;
+}
+
+void Ticker::loop() {
+  unique_lock lock{m_lock};
+  while (!m_stopping) {
+    // Idle: no timeout, so the thread stays asleep until it is needed.
+    m_wake.wait(lock, [this] { return m_running || m_stopping; });
+
+    auto next{steady_clock::now() + m_period};
+    while (!m_wake.wait_until(lock, next,
+                              [this] { return !m_running || m_stopping; })) {
+      lock.unlock();
+      m_tick();
+      lock.lock();
+
+      next += m_period;
+      auto now{steady_clock::now()};
+      if (next < now)
+        next = now + m_period;
+    }
+  }
+}
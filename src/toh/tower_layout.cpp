@@ -0,0 +1,27 @@
+#include "toh/tower_layout.h"
+
+#include <algorithm>
+
+using namespace std;
+
+size_t TowerLayout::halfWidth(size_t disk) const {
+  auto half{columns / 2};
+  if (disk == 0 || disks <= half)
+    return disk;
+  return half == 0 ? 0 : max(disk * half / disks, size_t{1});
+}
+
+vector<size_t> TowerLayout::visibleRows(const vector<size_t> &tower) const {
+  if (tower.size() <= rows)
+    return tower;
+  // Band `row` holds the disks from `row * size / bands` up to the next band.
+  // The top row stays free for a selected tower to lift its top disk to.
+  auto bands{max(rows, size_t{2}) - 1};
+  vector<size_t> visible(bands);
+  for (size_t row{0}; row < bands; row += 1)
+    visible[row] = tower[row * tower.size() / bands];
+  // The last band shows the top disk rather than its largest one: it is the
+  // disk the player moves next.
+  visible.back() = tower.back();
+  return visible;
+}
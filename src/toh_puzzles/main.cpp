@@ -0,0 +1,85 @@
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "libtoh/puzzle.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: toh_puzzles --disks N --count N --output FILE [--seed N]\n"
+    "                   [--threads N]\n"
+    "  --disks    number of disks of every puzzle, at most 40\n"
+    "  --count    number of puzzles\n"
+    "  --output   file to write the labeled puzzles to\n"
+    "  --seed     seed of the corpus; the same seed gives the same file\n"
+    "             (default 0)\n"
+    "  --threads  generating threads (default all cores)\n"};
+
+struct Options {
+  size_t disks{0};
+  uint64_t count{0};
+  string output{};
+  uint64_t seed{0};
+  size_t threads{max(thread::hardware_concurrency(), 1u)};
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  auto hasDisks{false};
+  auto hasCount{false};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    if (i + 1 == argc)
+      return nullopt;
+    if (arg == "--output") {
+      options.output = argv[i + 1];
+      continue;
+    }
+    try {
+      if (arg == "--disks") {
+        options.disks = stoul(argv[i + 1]);
+        hasDisks = true;
+      } else if (arg == "--count") {
+        options.count = stoull(argv[i + 1]);
+        hasCount = true;
+      } else if (arg == "--seed") {
+        options.seed = stoull(argv[i + 1]);
+      } else if (arg == "--threads") {
+        options.threads = stoul(argv[i + 1]);
+      } else {
+        return nullopt;
+      }
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (!hasDisks || !hasCount || options.disks > MaxPuzzleDisks ||
+      options.output.empty() || options.threads == 0)
+    return nullopt;
+  return options;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  auto start{steady_clock::now()};
+  if (!writePuzzleFile(options->output, options->disks, options->count,
+                       options->seed, options->threads)) {
+    cerr << format("toh_puzzles: cannot write '{}'", options->output) << endl;
+    return 1;
+  }
+  auto seconds{duration<double>(steady_clock::now() - start).count()};
+  cout << format("{} puzzles of {} disks in {:.2f} s, {:.0f} puzzles/s\n",
+                 options->count, options->disks, seconds,
+                 seconds > 0 ? static_cast<double>(options->count) / seconds
+                             : 0.0);
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "libtoh/optimal_path.h"
+
+/**
+ * @brief The size of the header at the start of a solve file; the moves
+ * follow it.
+ */
+inline constexpr size_t SolveHeaderSize{4096};
+
+/**
+ * @brief The number of moves a worker writes between two checkpoints.
+ */
+inline constexpr uint64_t SolveCheckpoint{uint64_t{1} << 22};
+
+/**
+ * @struct SolveHeader
+ * @brief The layout of the header of a solve file.
+ *
+ * A solve file holds `solveToh(disks, Left, Middle, Right)`, one move per
+ * nibble, `from * 3 + to`, with the move of even index in the low nibble of
+ * its byte. The moves are split into shards of `shardMoves` moves, an even
+ * number, so no two shards share a byte. `progress` counts the moves of each
+ * shard known to be on disk: a restarted run resumes every shard from there.
+ *
+ * Like a spectate segment, the header holds no pointers and its atomics are
+ * lock-free, so every worker process updates it through its own mapping.
+ */
+struct SolveHeader {
+  static constexpr uint32_t Magic{0x53484F54}; ///< `TOHS` in little endian.
+  static constexpr uint32_t Version{1};        ///< The layout version.
+  static constexpr size_t MaxShards{256};      ///< The most shards of a file.
+
+  std::atomic<uint32_t> magic{0}; ///< Magic, written once the rest is set.
+  uint32_t version{Version};      ///< The layout version.
+  uint64_t disks{0};              ///< The number of disks.
+  uint64_t shards{0};             ///< The number of shards.
+  uint64_t shardMoves{0};         ///< The moves of every shard but the last.
+  std::atomic<uint64_t> next{0};  ///< The next shard to claim in this run.
+  std::array<std::atomic<uint64_t>, MaxShards>
+      progress{}; ///< The moves of each shard on disk.
+};
+
+static_assert(sizeof(SolveHeader) <= SolveHeaderSize);
+
+/**
+ * @class SolveFile
+ * @brief Maps a solve file and writes the optimal solution into it, one
+ * shard at a time.
+ *
+ * The file is preallocated when created and mapped shared, so processes
+ * forked after open() write their shards straight into it. Every
+ * SolveCheckpoint moves a worker flushes what it wrote, then records its
+ * progress and flushes the header, so a checkpoint never gets ahead of the
+ * moves it counts, even across a power cut. Written pages are dropped from
+ * the mapping once flushed: memory use does not grow with the file.
+ *
+ * ### Example
+ * ```cpp
+ * #include "toh_solve/solve_file.h"
+ *
+ * using namespace std;
+ *
+ * int main() {
+ *   auto file{SolveFile::open("moves.toh")};
+ *   if (!file)
+ *     file = SolveFile::create("moves.toh", 30, 64);
+ *   if (!file || !solveInProcesses(*file, 8))
+ *     return 1; // Run it again to resume
+ *   return file->move(0) == toh::Move{toh::Left, toh::Middle} ? 0 : 1;
+ * }
+ * ```
+ */
+class SolveFile {
+public:
+  /**
+   * @brief Creates, preallocates and maps a new solve file.
+   * @param path The path of the file; it must not exist.
+   * @param disks The number of disks, at most toh::MaxPathDisks.
+   * @param shards The number of shards, at most SolveHeader::MaxShards.
+   * @return The file, or nullptr if it cannot be created.
+   */
+  static std::unique_ptr<SolveFile> create(const std::string &path,
+                                           size_t disks, size_t shards);
+
+  /**
+   * @brief Maps an existing solve file to resume or read it.
+   * @param path The path of the file.
+   * @return The file, or nullptr if it is missing or not a solve file.
+   */
+  static std::unique_ptr<SolveFile> open(const std::string &path);
+
+  /**
+   * @brief Deleted copy constructor.
+   * @param src The source SolveFile object (unused).
+   */
+  SolveFile(const SolveFile &src) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator.
+   * @param src The source SolveFile object (unused).
+   * @return Deleted.
+   */
+  SolveFile &operator=(const SolveFile &src) = delete;
+
+  /**
+   * @brief Unmaps the file.
+   */
+  ~SolveFile();
+
+  /**
+   * @brief Gets the number of disks.
+   * @return The number of disks.
+   */
+  [[nodiscard]] size_t disks() const;
+
+  /**
+   * @brief Gets the number of shards.
+   * @return The number of shards.
+   */
+  [[nodiscard]] size_t shards() const;
+
+  /**
+   * @brief Gets the number of moves of a shard.
+   * @param shard The shard.
+   * @return The number of moves.
+   */
+  [[nodiscard]] uint64_t shardLength(size_t shard) const;
+
+  /**
+   * @brief Gets the number of moves of a shard known to be written.
+   * @param shard The shard.
+   * @return The moves written up to the last checkpoint.
+   */
+  [[nodiscard]] uint64_t progress(size_t shard) const;
+
+  /**
+   * @brief Checks whether every move has been written.
+   * @return true if every shard is complete.
+   */
+  [[nodiscard]] bool isComplete() const;
+
+  /**
+   * @brief Starts a new run: shards are claimed from the first again.
+   *
+   * Call it before forking the workers of a run.
+   */
+  void rewind();
+
+  /**
+   * @brief Claims the next shard that is not complete, once per run across
+   * every process mapping the file.
+   * @return The shard, or std::nullopt if none is left.
+   */
+  std::optional<size_t> claim();
+
+  /**
+   * @brief Writes the moves of a shard from its last checkpoint on.
+   * @param shard The shard, claimed by the caller.
+   * @param limit The largest number of moves to write.
+   * @return The number of moves written, all of them checkpointed.
+   */
+  uint64_t solve(size_t shard, uint64_t limit = ~uint64_t{0});
+
+  /**
+   * @brief Reads a move back.
+   * @param index The index of the move, less than toh::optimalLength().
+   * @return The move, or two End towers if it has not been written.
+   */
+  [[nodiscard]] toh::Move move(uint64_t index) const;
+
+private:
+  /**
+   * @brief Takes ownership of a mapped file.
+   * @param memory The mapping.
+   * @param size The size of the mapping.
+   */
+  SolveFile(void *memory, size_t size);
+
+  /**
+   * @brief Flushes part of the mapping to disk.
+   * @param offset The first byte.
+   * @param size The number of bytes.
+   * @param release Whether to drop the pages from the mapping too.
+   */
+  void flush(size_t offset, size_t size, bool release);
+
+private:
+  SolveHeader *m_header; ///< The header, at the start of the mapping.
+  uint8_t *m_moves;      ///< The packed moves, after the header.
+  size_t m_size;         ///< The size of the mapping.
+};
+
+/**
+ * @brief Solves every remaining shard of a file in worker processes.
+ *
+ * Forks the workers, which claim shards until none is left, and waits for
+ * them. A worker that dies loses at most SolveCheckpoint moves of its shard;
+ * the next run redoes them.
+ *
+ * @param file The file, mapped before the call.
+ * @param workers The number of worker processes.
+ * @return true if the file is complete.
+ */
+bool solveInProcesses(SolveFile &file, size_t workers);
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <thread>
+
+#include "toh_solve/solve_file.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: toh_solve --disks N --output FILE [--workers N] [--shards N]\n"
+    "  --disks    number of disks, at most 63\n"
+    "  --output   file to write the packed moves to; an unfinished file of\n"
+    "             the same number of disks is resumed\n"
+    "  --workers  worker processes (default all cores)\n"
+    "  --shards   ranges of moves the work is split into, at most 256\n"
+    "             (default 64); a resumed file keeps its own\n"};
+
+struct Options {
+  size_t disks{0};
+  string output{};
+  size_t workers{max(thread::hardware_concurrency(), 1u)};
+  size_t shards{64};
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    if (i + 1 == argc)
+      return nullopt;
+    if (arg == "--output") {
+      options.output = argv[i + 1];
+      continue;
+    }
+    size_t *target{arg == "--disks"     ? &options.disks
+                   : arg == "--workers" ? &options.workers
+                   : arg == "--shards"  ? &options.shards
+                                        : nullptr};
+    if (!target)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.disks == 0 || options.output.empty() || options.workers == 0 ||
+      options.shards == 0 || options.shards > SolveHeader::MaxShards)
+    return nullopt;
+  return options;
+}
+
+// Opens the output to resume it, or creates it.
+unique_ptr<SolveFile> openOutput(const Options &options) {
+  if (!filesystem::exists(options.output)) {
+    auto file{SolveFile::create(options.output, options.disks, options.shards)};
+    if (!file)
+      cerr << format("toh_solve: cannot create '{}'", options.output) << endl;
+    return file;
+  }
+  auto file{SolveFile::open(options.output)};
+  if (!file) {
+    cerr << format("toh_solve: '{}' is not a solve file", options.output)
+         << endl;
+  } else if (file->disks() != options.disks) {
+    cerr << format("toh_solve: '{}' holds {} disks, not {}", options.output,
+                   file->disks(), options.disks)
+         << endl;
+    file.reset();
+  }
+  return file;
+}
+
+uint64_t checkpointed(const SolveFile &file) {
+  uint64_t moves{0};
+  for (size_t shard{0}; shard < file.shards(); shard += 1)
+    moves += file.progress(shard);
+  return moves;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+  auto file{openOutput(*options)};
+  if (!file)
+    return 1;
+
+  auto length{optimalLength(file->disks())};
+  auto before{checkpointed(*file)};
+  size_t remaining{0};
+  for (size_t shard{0}; shard < file->shards(); shard += 1)
+    remaining += file->progress(shard) < file->shardLength(shard) ? 1 : 0;
+  cout << format("{} disks, {} moves, {} of {} shards to solve with {} "
+                 "workers\n",
+                 file->disks(), length, remaining, file->shards(),
+                 options->workers);
+
+  auto start{steady_clock::now()};
+  auto complete{solveInProcesses(*file, options->workers)};
+  auto seconds{duration<double>(steady_clock::now() - start).count()};
+  auto written{checkpointed(*file) - before};
+  cout << format("{} moves in {:.1f} s, {:.0f} moves/s\n", written, seconds,
+                 seconds > 0 ? static_cast<double>(written) / seconds : 0.0);
+  if (!complete) {
+    cerr << format("toh_solve: a worker stopped early, run again to resume")
+         << endl;
+    return 1;
+  }
+  return 0;
+}
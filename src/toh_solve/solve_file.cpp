@@ -0,0 +1,258 @@
+#include "toh_solve/solve_file.h"
+
+#include <algorithm>
+#include <new>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <csignal>
+#include <sys/prctl.h>
+#endif
+
+using namespace std;
+using namespace toh;
+
+namespace {
+// The bytes of the moves of a game, two moves per byte.
+uint64_t movesSize(size_t disks) {
+  auto length{optimalLength(disks)};
+  return length / 2 + length % 2;
+}
+
+uint8_t packMove(Move move) {
+  return static_cast<uint8_t>(move.from * 3 + move.to);
+}
+
+#if !defined(_WIN32)
+// Maps a whole descriptor and closes it; the mapping outlives it.
+void *mapFile(int descriptor, size_t size) {
+  auto memory{mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   descriptor, 0)};
+  close(descriptor);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+#endif
+} // namespace
+
+unique_ptr<SolveFile> SolveFile::create(const string &path, size_t disks,
+                                        size_t shards) {
+#if !defined(_WIN32)
+  if (disks == 0 || disks > MaxPathDisks || shards == 0 ||
+      shards > SolveHeader::MaxShards || movesSize(disks) > uint64_t{1} << 62)
+    return nullptr;
+  auto descriptor{::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)};
+  if (descriptor < 0)
+    return nullptr;
+  auto size{SolveHeaderSize + static_cast<size_t>(movesSize(disks))};
+  // Reserving the blocks now turns a full disk into an error here instead of
+  // a SIGBUS hours into the run.
+#if defined(__linux__)
+  auto reserved{posix_fallocate(descriptor, 0, static_cast<off_t>(size)) == 0};
+#else
+  auto reserved{ftruncate(descriptor, static_cast<off_t>(size)) == 0};
+#endif
+  auto memory{reserved ? mapFile(descriptor, size) : nullptr};
+  if (!reserved)
+    close(descriptor);
+  if (!memory) {
+    unlink(path.c_str());
+    return nullptr;
+  }
+
+  auto header{new (memory) SolveHeader{}};
+  header->disks = disks;
+  header->shards = shards;
+  // Shards start on a byte, so no two workers ever write the same one.
+  auto length{optimalLength(disks)};
+  auto shardMoves{length / shards + (length % shards == 0 ? 0 : 1)};
+  header->shardMoves = shardMoves + shardMoves % 2;
+  header->magic.store(SolveHeader::Magic, memory_order_release);
+  unique_ptr<SolveFile> file{new SolveFile{memory, size}};
+  file->flush(0, SolveHeaderSize, false);
+  return file;
+#else
+  static_cast<void>(path);
+  static_cast<void>(disks);
+  static_cast<void>(shards);
+  return nullptr;
+#endif
+}
+
+unique_ptr<SolveFile> SolveFile::open(const string &path) {
+#if !defined(_WIN32)
+  auto descriptor{::open(path.c_str(), O_RDWR)};
+  if (descriptor < 0)
+    return nullptr;
+  struct stat status{};
+  if (fstat(descriptor, &status) != 0 ||
+      static_cast<size_t>(status.st_size) < SolveHeaderSize) {
+    close(descriptor);
+    return nullptr;
+  }
+  auto size{static_cast<size_t>(status.st_size)};
+  auto memory{mapFile(descriptor, size)};
+  if (!memory)
+    return nullptr;
+
+  unique_ptr<SolveFile> file{new SolveFile{memory, size}};
+  const auto &header{*file->m_header};
+  if (header.magic.load(memory_order_acquire) != SolveHeader::Magic ||
+      header.version != SolveHeader::Version || header.disks == 0 ||
+      header.disks > MaxPathDisks || header.shards == 0 ||
+      header.shards > SolveHeader::MaxShards ||
+      size != SolveHeaderSize + movesSize(header.disks))
+    return nullptr;
+  return file;
+#else
+  static_cast<void>(path);
+  return nullptr;
+#endif
+}
+
+SolveFile::SolveFile(void *memory, size_t size)
+    : m_header{static_cast<SolveHeader *>(memory)},
+      m_moves{static_cast<uint8_t *>(memory) + SolveHeaderSize}, m_size{size} {}
+
+SolveFile::~SolveFile() {
+#if !defined(_WIN32)
+  munmap(m_header, m_size);
+#endif
+}
+
+size_t SolveFile::disks() const { return m_header->disks; }
+
+size_t SolveFile::shards() const { return m_header->shards; }
+
+uint64_t SolveFile::shardLength(size_t shard) const {
+  auto length{optimalLength(disks())};
+  auto begin{min(shard * m_header->shardMoves, length)};
+  return min(m_header->shardMoves, length - begin);
+}
+
+uint64_t SolveFile::progress(size_t shard) const {
+  return m_header->progress.at(shard).load(memory_order_acquire);
+}
+
+bool SolveFile::isComplete() const {
+  for (size_t shard{0}; shard < shards(); shard += 1)
+    if (progress(shard) < shardLength(shard))
+      return false;
+  return true;
+}
+
+void SolveFile::rewind() { m_header->next.store(0, memory_order_release); }
+
+optional<size_t> SolveFile::claim() {
+  while (true) {
+    auto shard{m_header->next.fetch_add(1, memory_order_acq_rel)};
+    if (shard >= shards())
+      return nullopt;
+    if (progress(shard) < shardLength(shard))
+      return shard;
+  }
+}
+
+uint64_t SolveFile::solve(size_t shard, uint64_t limit) {
+  auto first{shard * m_header->shardMoves};
+  auto done{progress(shard)};
+  auto end{first + shardLength(shard)};
+  uint64_t written{0};
+  while (first + done < end && written < limit) {
+    auto begin{first + done};
+    auto last{begin + min({SolveCheckpoint, end - begin, limit - written})};
+
+    auto index{begin};
+    // A shard stopped by a limit may resume halfway through a byte.
+    if (index % 2 != 0) {
+      auto &byte{m_moves[index / 2]};
+      byte = static_cast<uint8_t>(
+          (byte & 0x0F) | packMove(optimalMove(disks(), index)) << 4);
+      index += 1;
+    }
+    for (; index + 1 < last; index += 2)
+      m_moves[index / 2] = static_cast<uint8_t>(
+          packMove(optimalMove(disks(), index)) |
+          packMove(optimalMove(disks(), index + 1)) << 4);
+    if (index < last) {
+      auto &byte{m_moves[index / 2]};
+      byte = static_cast<uint8_t>((byte & 0xF0) |
+                                  packMove(optimalMove(disks(), index)));
+    }
+
+    flush(SolveHeaderSize + begin / 2, (last + 1) / 2 - begin / 2, true);
+    done += last - begin;
+    written += last - begin;
+    m_header->progress[shard].store(done, memory_order_release);
+    flush(0, SolveHeaderSize, false);
+  }
+  return written;
+}
+
+Move SolveFile::move(uint64_t index) const {
+  auto shard{index / m_header->shardMoves};
+  if (index >= optimalLength(disks()) ||
+      index - shard * m_header->shardMoves >= progress(shard))
+    return {};
+  auto byte{m_moves[index / 2]};
+  auto code{index % 2 == 0 ? byte & 0x0F : byte >> 4};
+  return {static_cast<Position>(code / 3), static_cast<Position>(code % 3)};
+}
+
+void SolveFile::flush(size_t offset, size_t size, bool release) {
+#if !defined(_WIN32)
+  static const auto page{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+  auto start{offset / page * page};
+  auto address{reinterpret_cast<uint8_t *>(m_header) + start};
+  auto length{offset + size - start};
+  msync(address, length, MS_SYNC);
+  if (release)
+    madvise(address, length, MADV_DONTNEED);
+#else
+  static_cast<void>(offset);
+  static_cast<void>(size);
+  static_cast<void>(release);
+#endif
+}
+
+bool solveInProcesses(SolveFile &file, size_t workers) {
+#if !defined(_WIN32)
+  file.rewind();
+  auto parent{getpid()};
+  vector<pid_t> children{};
+  for (size_t i{0}; i < workers; i += 1) {
+    auto child{fork()};
+    if (child == 0) {
+#if defined(__linux__)
+      // A worker outliving a killed driver would race the next run.
+      prctl(PR_SET_PDEATHSIG, SIGKILL);
+      if (getppid() != parent)
+        _exit(1);
+#endif
+      auto status{0};
+      try {
+        while (auto shard{file.claim()})
+          file.solve(*shard);
+      } catch (...) {
+        status = 1;
+      }
+      _exit(status);
+    }
+    if (child > 0)
+      children.push_back(child);
+  }
+  for (auto child : children)
+    waitpid(child, nullptr, 0);
+  return file.isComplete();
+#else
+  static_cast<void>(file);
+  static_cast<void>(workers);
+  return false;
+#endif
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include "libtoh/bot_scheduler.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+Bot solver(const Game &game) {
+  vector<Position> plays{};
+  solveToh(plays, game.getTower(Left).size(), Left, Middle, Right);
+  for (size_t i{0}; i < plays.size(); i += 2)
+    co_yield Move{plays[i], plays[i + 1]};
+}
+
+// Plays the iterative solution from what it observes: the smallest disk
+// moves every other turn, one tower further each time, and in between the
+// only other legal move is played by trying both directions.
+Bot observer(const Game &game) {
+  auto disks{game.getTower(Left).size()};
+  auto step{disks % 2 == 0 ? 1 : 2};
+  size_t smallest{Left};
+  while (!game.isFinished()) {
+    auto next{(smallest + static_cast<size_t>(step)) % 3};
+    co_yield Move{static_cast<Position>(smallest), static_cast<Position>(next)};
+    smallest = next;
+    if (game.isFinished())
+      break;
+    auto first{static_cast<Position>((smallest + 1) % 3)};
+    auto second{static_cast<Position>((smallest + 2) % 3)};
+    if (!(co_yield Move{first, second}))
+      co_yield Move{second, first};
+  }
+}
+
+// Plays fixed moves and records whether each was legal.
+Bot recorder(const Game &, vector<Move> moves, vector<bool> &legal) {
+  for (auto &&move : moves)
+    legal.push_back(co_yield move);
+}
+
+} // namespace
+
+TEST(Bot_Scheduler_Tests, Test_Bots_Solve_Every_Game) {
+  // given
+  BotScheduler scheduler{4};
+  for (size_t i{0}; i < 1000; i += 1)
+    scheduler.spawn(Game{1 + i % 8}, i % 2 ? solver : observer);
+
+  // when
+  auto report{scheduler.run()};
+
+  // then
+  ASSERT_EQ(report.finished, 1000);
+  for (size_t i{0}; i < scheduler.size(); i += 1)
+    ASSERT_TRUE(scheduler.game(i).isFinished());
+  uint64_t optimal{0};
+  for (size_t i{0}; i < 1000; i += 1)
+    optimal += optimalLength(1 + i % 8);
+  ASSERT_EQ(report.moves, optimal);
+}
+
+TEST(Bot_Scheduler_Tests, Test_Bots_Are_Stolen) {
+  // given
+  BotScheduler scheduler{4};
+  // Only the bots of the first worker have long games.
+  for (size_t i{0}; i < 400; i += 1)
+    scheduler.spawn(Game{i % 4 == 0 ? size_t{12} : size_t{1}}, solver);
+
+  // when
+  auto report{scheduler.run()};
+
+  // then
+  ASSERT_EQ(report.finished, 400);
+  ASSERT_GT(report.steals, 0);
+}
+
+TEST(Bot_Scheduler_Tests, Test_Bot_Rejected_Moves) {
+  // given
+  BotScheduler scheduler{1};
+  vector<bool> legal{};
+  scheduler.spawn(Game{3}, [&](const Game &game) {
+    return recorder(game, {{Middle, Right}, {Left, Right}, {Left, Right}},
+                    legal);
+  });
+
+  // when
+  auto report{scheduler.run()};
+
+  // then
+  ASSERT_EQ(legal, (vector<bool>{false, true, false}));
+  ASSERT_EQ(report.moves, 1);
+  ASSERT_EQ(report.rejected, 2);
+  ASSERT_EQ(report.finished, 0);
+  ASSERT_TRUE(scheduler.game(0).isSelected(End));
+}
+
+TEST(Bot_Scheduler_Tests, Test_Bot_Exception) {
+  // given
+  BasicBotScheduler<CyclicGame> scheduler{2};
+  scheduler.spawn(CyclicGame{2}, [](const CyclicGame &) -> Bot {
+    co_yield Move{Left, Middle};
+    throw runtime_error{"bot failed"};
+  });
+  scheduler.spawn(CyclicGame{2}, [](const CyclicGame &) -> Bot { co_return; });
+
+  // then
+  ASSERT_THROW(scheduler.run(), runtime_error);
+  ASSERT_THROW(BotScheduler{0}, invalid_argument);
+}
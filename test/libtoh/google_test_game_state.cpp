@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include "libtoh/game_state.h"
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace toh;
+
+using Tower = vector<size_t>;
+using Play = vector<Position>;
+
+TEST(Game_State_Tests, Test_Game_State_Initial) {
+  // given
+  GameState state{3};
+
+  // then
+  ASSERT_EQ(state.getTower(Left), (Tower{3, 2, 1}));
+  ASSERT_EQ(state.getTower(Middle), (Tower{}));
+  ASSERT_EQ(state.getTower(Right), (Tower{}));
+  ASSERT_EQ(state.height(Left), 3);
+  ASSERT_EQ(state.top(Left), 1);
+  ASSERT_EQ(state.top(Right), 0);
+  ASSERT_TRUE(state.isSelected(End));
+  ASSERT_FALSE(state.isFinished());
+}
+
+TEST(Game_State_Tests, Test_Game_State_From_Game) {
+  // given
+  Game game{3};
+  game.select(Left);
+  game.select(Right);
+  game.select(Left);
+
+  // when
+  GameState state{game};
+
+  // then
+  ASSERT_EQ(state.getTower(Left), game.getTower(Left));
+  ASSERT_EQ(state.getTower(Middle), game.getTower(Middle));
+  ASSERT_EQ(state.getTower(Right), game.getTower(Right));
+  ASSERT_TRUE(state.isSelected(Left));
+}
+
+TEST(Game_State_Tests, Test_Game_State_Select_Matches_Game) {
+  // given
+  Game game{3};
+  GameState state{3};
+  Play play{Right, Left,   Middle, Left,  Left,  Right, Left, Middle,
+            Left,  Middle, Right,  Right, Right, Left,  End,  Middle};
+
+  for (auto &&choice : play) {
+    // when
+    game.select(choice);
+    state = state.select(choice);
+
+    // then
+    ASSERT_EQ(state, GameState{game});
+  }
+}
+
+TEST(Game_State_Tests, Test_Game_State_Snapshots_Are_Persistent) {
+  // given
+  GameState root{3};
+
+  // when
+  auto middle{root.select(Left).select(Middle)};
+  auto right{root.select(Left).select(Right)};
+
+  // then
+  ASSERT_EQ(root, GameState{3});
+  ASSERT_EQ(middle.getTower(Left), (Tower{3, 2}));
+  ASSERT_EQ(middle.getTower(Middle), (Tower{1}));
+  ASSERT_EQ(right.getTower(Left), (Tower{3, 2}));
+  ASSERT_EQ(right.getTower(Right), (Tower{1}));
+  ASSERT_NE(middle, right);
+}
+
+TEST(Game_State_Tests, Test_Game_State_Illegal_Move) {
+  // given
+  auto state{GameState{3}.select(Left).select(Right)};
+
+  // when
+  auto moved{state.move(Left, Right)};
+
+  // then
+  ASSERT_FALSE(moved.has_value());
+  ASSERT_FALSE(state.move(Middle, Right).has_value());
+  ASSERT_FALSE(state.move(Left, End).has_value());
+  ASSERT_TRUE(state.move(Right, Middle).has_value());
+}
+
+TEST(Game_State_Tests, Test_Game_State_Play_10) {
+  // given
+  Game game{10};
+  GameState state{10};
+  Play plays{};
+  solveToh(plays, 10, Left, Middle, Right);
+  vector<GameState> history{state};
+
+  // when
+  for (auto &&choice : plays) {
+    game.select(choice);
+    state = state.select(choice);
+    history.push_back(state);
+  }
+
+  // then
+  ASSERT_TRUE(state.isFinished());
+  ASSERT_EQ(state, GameState{game});
+  ASSERT_EQ(state.getTower(Right), (Tower{10, 9, 8, 7, 6, 5, 4, 3, 2, 1}));
+  ASSERT_EQ(history.front(), GameState{10});
+  ASSERT_FALSE(history.front().isFinished());
+}
@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "libtoh/metrics.h"
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace toh;
+using namespace toh::metrics;
+
+TEST(Metrics_Tests, Test_Metrics_Count_Moves) {
+  // given
+  auto selects{value(Metric::Selects)};
+  auto moves{value(Metric::Moves)};
+  auto rejected{value(Metric::RejectedMoves)};
+  Game game{2};
+
+  // when
+  game.select(Left);
+  game.select(Right);
+  game.select(Left);
+  game.select(Right);
+
+  // then
+  auto expected{[](int64_t count) { return isEnabled() ? count : 0; }};
+  ASSERT_EQ(value(Metric::Selects) - selects, expected(4));
+  ASSERT_EQ(value(Metric::Moves) - moves, expected(1));
+  ASSERT_EQ(value(Metric::RejectedMoves) - rejected, expected(1));
+}
+
+TEST(Metrics_Tests, Test_Metrics_Empty_Selection_Is_No_Move) {
+  // given
+  auto selects{value(Metric::Selects)};
+  auto rejected{value(Metric::RejectedMoves)};
+  Game game{2};
+
+  // when
+  game.select(Middle);
+  game.select(Right);
+
+  // then
+  ASSERT_EQ(value(Metric::Selects) - selects, isEnabled() ? 2 : 0);
+  ASSERT_EQ(value(Metric::RejectedMoves) - rejected, 0);
+  ASSERT_TRUE(game.isSelected(End));
+}
+
+TEST(Metrics_Tests, Test_Metrics_Summed_Over_Threads) {
+  // given
+  auto moves{value(Metric::Moves)};
+
+  // when
+  vector<thread> threads{};
+  for (size_t i{0}; i < 4; i += 1) {
+    threads.emplace_back([] {
+      Game game{1};
+      for (size_t j{0}; j < 1000; j += 1) {
+        auto from{game.getTower(Left).empty() ? Right : Left};
+        game.select(from);
+        game.select(from == Left ? Right : Left);
+      }
+    });
+  }
+  for (auto &&worker : threads)
+    worker.join();
+
+  // then
+  ASSERT_EQ(value(Metric::Moves) - moves, isEnabled() ? 4000 : 0);
+}
+
+TEST(Metrics_Tests, Test_Metrics_Scoped_Gauge) {
+  // given
+  auto active{value(Metric::ActiveSessions)};
+
+  // when
+  optional<int64_t> during{};
+  {
+    TOH_METRICS_SCOPE(ActiveSessions);
+    during = value(Metric::ActiveSessions);
+  }
+
+  // then
+  ASSERT_EQ(*during - active, isEnabled() ? 1 : 0);
+  ASSERT_EQ(value(Metric::ActiveSessions), active);
+}
+
+TEST(Metrics_Tests, Test_Metrics_Prometheus_Text) {
+  // when
+  ostringstream out{};
+  writePrometheus(out);
+
+  // then
+  auto text{out.str()};
+  if (!isEnabled()) {
+    ASSERT_TRUE(text.empty());
+    return;
+  }
+  ASSERT_NE(text.find("# TYPE toh_moves_total counter\ntoh_moves_total "),
+            string::npos);
+  ASSERT_NE(text.find("# TYPE toh_active_sessions gauge\n"), string::npos);
+  ASSERT_EQ(text.back(), '\n');
+}
+
+TEST(Metrics_Tests, Test_Metrics_Prometheus_File) {
+  // given
+  auto path{testing::TempDir() + "toh_metrics_test.prom"};
+
+  // when
+  auto first{writePrometheusFile(path)};
+  auto second{writePrometheusFile(path)};
+  ostringstream written{};
+  written << ifstream{path}.rdbuf();
+  auto leftover{ifstream{path + ".tmp"}.is_open()};
+  remove(path.c_str());
+
+  // then
+  ostringstream expected{};
+  writePrometheus(expected);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(written.str(), expected.str());
+  ASSERT_FALSE(leftover);
+}
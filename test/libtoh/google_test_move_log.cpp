@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include "libtoh/move_log.h"
+
+using namespace std;
+using namespace toh;
+
+using Moves = vector<Move>;
+
+namespace {
+Moves optimalMoves(size_t disks) {
+  Moves moves{};
+  for (uint64_t i{0}; i < optimalLength(disks); i += 1)
+    moves.push_back(optimalMove(disks, i));
+  return moves;
+}
+} // namespace
+
+TEST(Move_Log_Tests, Test_Perfect_Play_Is_Tiny) {
+  // given
+  auto moves{optimalMoves(20)};
+
+  // when
+  auto bytes{encodeMoveLog(20, moves)};
+  auto decoded{decodeMoveLog(bytes)};
+
+  // then
+  ASSERT_EQ(bytes.size(), 10);
+  ASSERT_TRUE(decoded);
+  ASSERT_EQ(*decoded, moves);
+}
+
+TEST(Move_Log_Tests, Test_Detours_Round_Trip) {
+  // given
+  auto moves{optimalMoves(6)};
+  // A wrong move taken back, an illegal move, and two optimal moves undone.
+  moves.insert(moves.begin() + 10, {{Left, Right}, {Right, Left}});
+  moves.insert(moves.begin() + 30, Move{Left, Left});
+  auto undone{moves.begin() + 40};
+  moves.insert(undone, {undone[-1].reversed(), undone[-2].reversed(),
+                        undone[-2], undone[-1]});
+
+  // when
+  auto bytes{encodeMoveLog(6, moves)};
+  auto decoded{decodeMoveLog(bytes)};
+
+  // then
+  ASSERT_TRUE(decoded);
+  ASSERT_EQ(*decoded, moves);
+  ASSERT_LT(bytes.size(), 24);
+}
+
+TEST(Move_Log_Tests, Test_Detours_Rejoin_Anywhere) {
+  // given
+  // The first disk reaches the first state of the path the long way round,
+  // so the detour rejoins the path one move after where it left it.
+  auto ahead{optimalMoves(16)};
+  ahead.erase(ahead.begin());
+  ahead.insert(ahead.begin(), {{Left, Right}, {Right, Middle}});
+  // Here it leaves that state for the new game, one move behind, and starts
+  // over.
+  auto behind{optimalMoves(6)};
+  behind.insert(behind.begin(),
+                {{Left, Middle}, {Middle, Right}, {Right, Left}});
+
+  // when
+  auto aheadBytes{encodeMoveLog(16, ahead)};
+  auto behindBytes{encodeMoveLog(6, behind)};
+  MoveLogReader reader{behindBytes};
+  Moves forward{};
+  while (auto move{reader.next()})
+    forward.push_back(*move);
+  Moves backward{};
+  while (auto move{reader.previous()})
+    backward.insert(backward.begin(), *move);
+
+  // then
+  ASSERT_EQ(decodeMoveLog(aheadBytes), ahead);
+  ASSERT_LE(aheadBytes.size(), 12);
+  ASSERT_EQ(decodeMoveLog(behindBytes), behind);
+  ASSERT_LE(behindBytes.size(), 12);
+  ASSERT_EQ(forward, behind);
+  ASSERT_EQ(backward, behind);
+}
+
+TEST(Move_Log_Tests, Test_Reader_Streams_Both_Ways) {
+  // given
+  auto moves{optimalMoves(4)};
+  moves.insert(moves.begin() + 5, {{Middle, Right}, {Right, Middle}});
+  auto bytes{encodeMoveLog(4, moves)};
+  MoveLogReader reader{bytes};
+
+  // when
+  Moves forward{};
+  while (auto move{reader.next()})
+    forward.push_back(*move);
+  Moves backward{};
+  while (auto move{reader.previous()})
+    backward.insert(backward.begin(), *move);
+
+  // then
+  ASSERT_TRUE(reader.isValid());
+  ASSERT_EQ(reader.disks(), 4);
+  ASSERT_EQ(forward, moves);
+  ASSERT_EQ(backward, moves);
+  ASSERT_EQ(reader.position(), 0);
+  ASSERT_EQ(reader.next(), moves[0]);
+}
+
+TEST(Move_Log_Tests, Test_Corrupted_Log) {
+  // given
+  auto bytes{encodeMoveLog(5, optimalMoves(5))};
+  auto truncated{bytes};
+  truncated.back() |= 0x80;
+  auto wrongVersion{bytes};
+  wrongVersion[4] += 1;
+  auto tooLong{bytes};
+  tooLong.push_back(1 << 2);
+  auto seekTooFar{bytes};
+  seekTooFar.push_back(1 << 3 | 3);
+
+  // then
+  ASSERT_FALSE(decodeMoveLog(truncated));
+  ASSERT_FALSE(decodeMoveLog(wrongVersion));
+  ASSERT_FALSE(MoveLogReader{wrongVersion}.isValid());
+  ASSERT_FALSE(decodeMoveLog(tooLong));
+  ASSERT_FALSE(decodeMoveLog(seekTooFar));
+  ASSERT_THROW(encodeMoveLog(5, Moves{{Left, End}}), invalid_argument);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include "libtoh/move_queue.h"
+
+using namespace std;
+using namespace toh;
+
+TEST(Move_Queue_Tests, Test_Single_Producer_Solves) {
+  // given
+  constexpr size_t Disks{6};
+  MoveQueue queue{Game{Disks}, 1, 16};
+  auto &player{queue.producer(0)};
+  uint64_t submitted{0};
+  uint64_t polled{0};
+
+  // when
+  while (polled < optimalLength(Disks)) {
+    while (submitted < optimalLength(Disks) &&
+           player.submit(optimalMove(Disks, submitted)))
+      submitted += 1;
+    queue.drain();
+    while (auto result{player.poll()}) {
+      // then
+      ASSERT_EQ(result->sequence, polled);
+      ASSERT_EQ(result->order, polled);
+      ASSERT_EQ(result->move, optimalMove(Disks, polled));
+      ASSERT_TRUE(result->accepted);
+      polled += 1;
+    }
+  }
+  ASSERT_TRUE(queue.game().isFinished());
+  ASSERT_EQ(player.pending(), 0);
+}
+
+TEST(Move_Queue_Tests, Test_Illegal_Moves_Are_Rejected) {
+  // given
+  CyclicQueue queue{CyclicGame{3}, 2};
+  queue.producer(0).submit({Middle, Left});
+  queue.producer(1).submit({Left, Left});
+  queue.producer(0).submit({Left, End});
+  queue.producer(1).submit({Left, Right});
+  queue.producer(0).submit({Left, Middle});
+
+  // when
+  auto drained{queue.drain()};
+
+  // then
+  ASSERT_EQ(drained, 5);
+  vector<bool> first{};
+  while (auto result{queue.producer(0).poll()})
+    first.push_back(result->accepted);
+  vector<bool> second{};
+  while (auto result{queue.producer(1).poll()})
+    second.push_back(result->accepted);
+  ASSERT_EQ(first, (vector<bool>{false, false, true}));
+  ASSERT_EQ(second, (vector<bool>{false, false}));
+  ASSERT_EQ(queue.game().getTower(Middle), (vector<size_t>{1}));
+}
+
+TEST(Move_Queue_Tests, Test_Full_Queue_Refuses_Moves) {
+  // given
+  MoveQueue queue{Game{3}, 2, 3};
+
+  // when
+  for (size_t i{0}; i < 4; i += 1)
+    ASSERT_EQ(queue.producer(i % 2).submit({Left, Middle}), i / 2);
+
+  // then
+  ASSERT_EQ(queue.producer(0).submit({Left, Middle}), nullopt);
+  ASSERT_EQ(queue.drain(2), 2);
+  ASSERT_EQ(queue.producer(0).submit({Middle, Left}), 2);
+  ASSERT_EQ(queue.drain(), 3);
+  ASSERT_EQ(queue.drain(), 0);
+  ASSERT_THROW((MoveQueue{Game{3}, 0}), invalid_argument);
+  ASSERT_THROW(static_cast<void>(queue.producer(2)), out_of_range);
+}
+
+TEST(Move_Queue_Tests, Test_Producers_Share_A_Game) {
+  // given
+  constexpr size_t Producers{4};
+  constexpr uint64_t Moves{10000};
+  MoveQueue queue{Game{5}, Producers, 64};
+  vector<uint64_t> accepted(Producers, 0);
+
+  // when
+  {
+    jthread applier{[&](stop_token stop) {
+      while (!stop.stop_requested())
+        if (queue.drain() == 0)
+          this_thread::yield();
+    }};
+    vector<jthread> players{};
+    for (size_t i{0}; i < Producers; i += 1) {
+      players.emplace_back([&queue, &accepted, i] {
+        auto &player{queue.producer(i)};
+        uint64_t submitted{0};
+        uint64_t polled{0};
+        while (polled < Moves) {
+          Move move{static_cast<Position>(submitted % 3),
+                    static_cast<Position>((submitted + i + 1) % 3)};
+          if (submitted < Moves && player.submit(move))
+            submitted += 1;
+          else
+            this_thread::yield();
+          while (auto result{player.poll()}) {
+            EXPECT_EQ(result->sequence, polled);
+            accepted[i] += result->accepted ? 1 : 0;
+            polled += 1;
+          }
+        }
+      });
+    }
+  }
+
+  // then
+  uint64_t total{0};
+  for (auto &&count : accepted)
+    total += count;
+  ASSERT_GT(total, 0);
+  size_t disks{0};
+  for (auto tower : {Left, Middle, Right})
+    disks += queue.game().getTower(tower).size();
+  ASSERT_EQ(disks, 5);
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include "libtoh/optimal_path.h"
+
+using namespace std;
+using namespace toh;
+
+TEST(Optimal_Path_Tests, Test_Optimal_Path_Matches_Solve_Toh) {
+  for (size_t disks{1}; disks <= 10; disks += 1) {
+    // given
+    vector<Position> solution{};
+    solveToh(solution, disks, Left, Middle, Right);
+    Game game{disks};
+
+    for (uint64_t i{0}; i < optimalLength(disks); i += 1) {
+      // when
+      auto move{optimalMove(disks, i)};
+      auto state{optimalState(disks, i)};
+
+      // then
+      ASSERT_EQ(move, (Move{solution[2 * i], solution[2 * i + 1]}));
+      ASSERT_EQ(GameBoard(state, End), static_cast<const GameBoard &>(game));
+      game.select(move.from);
+      game.select(move.to);
+    }
+    ASSERT_EQ(optimalState(disks, optimalLength(disks)),
+              vector<Position>(disks, Right));
+  }
+}
+
+TEST(Optimal_Path_Tests, Test_Optimal_Path_Largest) {
+  // given
+  auto last{optimalLength(MaxPathDisks) - 1};
+
+  // when
+  auto middle{optimalMove(MaxPathDisks, last / 2)};
+  auto move{optimalMove(MaxPathDisks, last)};
+  auto state{optimalState(MaxPathDisks, last + 1)};
+
+  // then
+  ASSERT_EQ(middle, (Move{Left, Right}));
+  ASSERT_EQ(move, (Move{Middle, Right}));
+  ASSERT_EQ(state, vector<Position>(MaxPathDisks, Right));
+}
+
+TEST(Optimal_Path_Tests, Test_Optimal_Index_Inverts_Path) {
+  for (size_t disks{0}; disks <= 8; disks += 1) {
+    // given
+    vector<Position> solution{};
+    solveToh(solution, disks, Left, Middle, Right);
+    Game game{disks};
+
+    for (uint64_t i{0}; i <= optimalLength(disks); i += 1) {
+      // when
+      auto index{optimalIndex(game)};
+
+      // then
+      ASSERT_EQ(index, i);
+      ASSERT_EQ(optimalIndex(optimalState(disks, i)), i);
+      if (i < optimalLength(disks)) {
+        game.select(solution[2 * i]);
+        game.select(solution[2 * i + 1]);
+      }
+    }
+  }
+}
+
+TEST(Optimal_Path_Tests, Test_Optimal_Index_Rejects_Other_States) {
+  // given
+  constexpr size_t Disks{7};
+  uint64_t states{1};
+  for (size_t i{0}; i < Disks; i += 1)
+    states *= 3;
+  vector<bool> found(optimalLength(Disks) + 1, false);
+  size_t onPath{0};
+
+  for (uint64_t state{0}; state < states; state += 1) {
+    vector<Position> pegs(Disks);
+    auto digits{state};
+    for (auto &&peg : pegs) {
+      peg = static_cast<Position>(digits % 3);
+      digits /= 3;
+    }
+
+    // when
+    auto index{optimalIndex(pegs)};
+
+    // then
+    if (!index)
+      continue;
+    onPath += 1;
+    ASSERT_FALSE(found[*index]);
+    ASSERT_EQ(optimalState(Disks, *index), pegs);
+    found[*index] = true;
+  }
+  ASSERT_EQ(onPath, found.size());
+}
+
+TEST(Optimal_Path_Tests, Test_Optimal_Index_Largest) {
+  // given
+  auto last{optimalLength(MaxPathDisks) - 1};
+
+  // when, then
+  for (auto index : {uint64_t{0}, last / 3, last / 2 + 1, last, last + 1})
+    ASSERT_EQ(optimalIndex(optimalState(MaxPathDisks, index)), index);
+  ASSERT_EQ(optimalIndex(vector<Position>(MaxPathDisks, Middle)), nullopt);
+  ASSERT_EQ(optimalIndex(vector<Position>(MaxPathDisks + 1, Left)), nullopt);
+  ASSERT_EQ(optimalIndex(GameBoard{MaxPathDisks + 1}), nullopt);
+}
+
+TEST(Optimal_Path_Tests, Test_Play_Move_Leaves_No_Selection) {
+  // given
+  AdjacentGame game{2};
+
+  // when
+  auto played{playMove(game, {Left, Middle})};
+  auto blocked{playMove(game, {Left, Middle})};
+  auto forbidden{playMove(game, {Left, Right})};
+  auto empty{playMove(game, {Right, Left})};
+
+  // then
+  ASSERT_TRUE(played);
+  ASSERT_FALSE(blocked);
+  ASSERT_FALSE(forbidden);
+  ASSERT_FALSE(empty);
+  ASSERT_TRUE(game.isSelected(End));
+  ASSERT_EQ(game.getTower(Middle), vector<size_t>{1});
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "libtoh/puzzle.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+uint64_t rankOf(const GameBoard &board) {
+  vector<uint64_t> digits{};
+  for (auto tower : {Left, Middle, Right})
+    for (auto disk : board.getTower(tower)) {
+      digits.resize(max(digits.size(), disk));
+      digits[disk - 1] = tower;
+    }
+  uint64_t rank{0};
+  for (auto it{digits.rbegin()}; it != digits.rend(); ++it)
+    rank = rank * 3 + *it;
+  return rank;
+}
+} // namespace
+
+TEST(Puzzle_Tests, Test_Labels_Are_Exact) {
+  for (size_t disks{1}; disks <= 7; disks += 1) {
+    for (uint64_t rank{0}; rank < puzzleCount(disks); rank += 1) {
+      // given
+      auto puzzle{labelPuzzle(disks, rank)};
+      GameBoard board{unrankPuzzle(disks, rank), End};
+      ASSERT_EQ(rankOf(board), rank);
+
+      // when, then
+      // No move gets closer than one less, and the labelled move does: the
+      // distances are those of a breadth-first search from the goal.
+      ASSERT_EQ(puzzle.distance == 0, board.isFinished());
+      for (auto from : {Left, Middle, Right}) {
+        for (auto to : {Left, Middle, Right}) {
+          Game game{unrankPuzzle(disks, rank), End};
+          game.select(from);
+          game.select(to);
+          if (from == to || !game.isSelected(End))
+            continue;
+          auto other{labelPuzzle(disks, rankOf(game))};
+          ASSERT_LE(puzzle.distance, other.distance + 1);
+          if (Move{from, to} == puzzle.next) {
+            ASSERT_EQ(other.distance + 1, puzzle.distance);
+          }
+        }
+      }
+      if (puzzle.distance > 0) {
+        Game game{unrankPuzzle(disks, rank), End};
+        game.select(puzzle.next.from);
+        game.select(puzzle.next.to);
+        ASSERT_TRUE(game.isSelected(End));
+        ASSERT_NE(rankOf(game), rank);
+      }
+    }
+  }
+}
+
+TEST(Puzzle_Tests, Test_Labels_Follow_Optimal_Path) {
+  // given
+  auto length{optimalLength(MaxPuzzleDisks)};
+
+  for (auto index : {uint64_t{0}, uint64_t{1}, length / 3, length - 1}) {
+    // when
+    auto rank{rankOf(GameBoard{optimalState(MaxPuzzleDisks, index), End})};
+    auto puzzle{labelPuzzle(MaxPuzzleDisks, rank)};
+
+    // then
+    ASSERT_EQ(puzzle.distance, length - index);
+    ASSERT_EQ(puzzle.next, optimalMove(MaxPuzzleDisks, index));
+  }
+  ASSERT_EQ(labelPuzzle(MaxPuzzleDisks, puzzleCount(MaxPuzzleDisks) - 1),
+            (Puzzle{puzzleCount(MaxPuzzleDisks) - 1, 0, {}}));
+}
+
+TEST(Puzzle_Tests, Test_Samples_Cover_Every_State) {
+  // given
+  constexpr size_t Disks{4};
+  vector<size_t> seen(puzzleCount(Disks), 0);
+
+  // when
+  for (uint64_t i{0}; i < 81000; i += 1)
+    seen[samplePuzzle(Disks, 7, i)] += 1;
+
+  // then
+  for (auto count : seen) {
+    ASSERT_GT(count, 800);
+    ASSERT_LT(count, 1200);
+  }
+  ASSERT_EQ(samplePuzzle(Disks, 7, 5), samplePuzzle(Disks, 7, 5));
+  ASSERT_EQ(samplePuzzle(0, 7, 5), 0);
+}
+
+TEST(Puzzle_Tests, Test_File_Is_Independent_Of_Threads) {
+  // given
+  auto path{testing::TempDir() + "toh_puzzle_test.bin"};
+  auto single{testing::TempDir() + "toh_puzzle_test_single.bin"};
+
+  // when
+  auto replaced{writePuzzleFile(path, 4, 5, 1, 1)};
+  auto written{writePuzzleFile(path, 20, 10007, 42, 3)};
+  auto writtenSingle{writePuzzleFile(single, 20, 10007, 42, 1)};
+  auto corpus{readPuzzleFile(path)};
+  auto corpusSingle{readPuzzleFile(single)};
+
+  // then
+  ASSERT_TRUE(replaced);
+  ASSERT_TRUE(written);
+  ASSERT_TRUE(writtenSingle);
+  ASSERT_TRUE(corpus);
+  ASSERT_EQ(corpus->disks, 20);
+  ASSERT_EQ(corpus->puzzles.size(), 10007);
+  for (uint64_t i{0}; i < corpus->puzzles.size(); i += 1)
+    ASSERT_EQ(corpus->puzzles[i], labelPuzzle(20, samplePuzzle(20, 42, i)));
+  ASSERT_EQ(corpus->puzzles, corpusSingle->puzzles);
+  ASSERT_FALSE(ifstream{path + ".tmp"}.is_open());
+
+  ofstream{path, ios::app} << 'x';
+  ASSERT_EQ(readPuzzleFile(path), nullopt);
+  remove(path.c_str());
+  remove(single.c_str());
+  ASSERT_EQ(readPuzzleFile(path), nullopt);
+  ASSERT_FALSE(writePuzzleFile(path, MaxPuzzleDisks + 1, 1, 0, 1));
+}
@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "libtoh/save_state.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+using Tower = vector<size_t>;
+using Play = vector<Position>;
+
+TEST(Save_State_Tests, Test_Save_State_Round_Trip) {
+  // given
+  Game game{10};
+  Play plays{};
+  solveToh(plays, 10, Left, Middle, Right);
+  for (size_t i{0}; i < 501; i += 1)
+    game.select(plays[i]);
+
+  // when
+  auto bytes{serialize(game, milliseconds{12345})};
+  auto state{deserialize<Game>(bytes)};
+
+  // then
+  ASSERT_EQ(bytes.size(), 23);
+  ASSERT_TRUE(state);
+  ASSERT_EQ(state->game, game);
+  ASSERT_EQ(state->elapsed, milliseconds{12345});
+  ASSERT_TRUE(state->game.isSelected(plays[500]));
+}
+
+TEST(Save_State_Tests, Test_Save_State_Resume_Play) {
+  // given
+  Game game{3};
+  Play plays{};
+  solveToh(plays, 3, Left, Middle, Right);
+  auto half{plays.begin() + 6};
+  for (auto play{plays.begin()}; play < half; advance(play, 1))
+    game.select(*play);
+
+  // when
+  auto state{deserialize<Game>(serialize(game))};
+  for (auto play{half}; play < plays.end(); advance(play, 1))
+    state->game.select(*play);
+
+  // then
+  ASSERT_EQ(state->game.getTower(Right), (Tower{3, 2, 1}));
+  ASSERT_TRUE(state->game.isFinished());
+}
+
+TEST(Save_State_Tests, Test_Save_State_Size_Is_Constant) {
+  // given
+  Game game{8};
+  auto before{serialize(game, milliseconds{1})};
+  Play plays{};
+  solveToh(plays, 8, Left, Middle, Right);
+  for (auto &&play : plays)
+    game.select(play);
+
+  // when
+  auto after{serialize(game, hours{100})};
+
+  // then
+  ASSERT_EQ(before.size(), after.size());
+}
+
+TEST(Save_State_Tests, Test_Save_State_Disk_Limit) {
+  // given
+  Game largest{MaxSaveStateDisks};
+  Game tooLarge{MaxSaveStateDisks + 1};
+
+  // when
+  auto state{deserialize<Game>(serialize(largest))};
+
+  // then
+  ASSERT_TRUE(state);
+  ASSERT_EQ(state->game, largest);
+  ASSERT_THROW(static_cast<void>(serialize(tooLarge)), invalid_argument);
+}
+
+TEST(Save_State_Tests, Test_Save_State_Rejects_Corruption) {
+  // given
+  auto bytes{serialize(Game{5}, milliseconds{42})};
+
+  for (size_t i{0}; i < bytes.size(); i += 1) {
+    // when
+    auto corrupted{bytes};
+    corrupted[i] ^= 0x10;
+
+    // then
+    ASSERT_FALSE(deserialize<Game>(corrupted)) << "byte " << i;
+  }
+  ASSERT_FALSE(deserialize<Game>(span{bytes}.first(bytes.size() - 1)));
+  ASSERT_FALSE(deserialize<Game>(vector<uint8_t>{}));
+}
+
+TEST(Save_State_Tests, Test_Save_State_Rejects_Other_Variant) {
+  // given
+  CyclicGame game{4};
+  game.select(Left);
+  game.select(Middle);
+
+  // when
+  auto bytes{serialize(game)};
+
+  // then
+  ASSERT_FALSE(deserialize<Game>(bytes));
+  ASSERT_EQ(deserialize<CyclicGame>(bytes)->game, game);
+}
+
+TEST(Save_State_Tests, Test_Save_State_File) {
+  // given
+  auto path{testing::TempDir() + "toh_save_state_test.sav"};
+  Game game{6};
+  game.select(Left);
+  auto bytes{serialize(game, seconds{7})};
+
+  // when
+  auto saved{saveToFile(path, serialize(Game{3}, seconds{1}))};
+  auto replaced{saveToFile(path, bytes)};
+  auto loaded{loadFromFile(path)};
+  auto leftover{ifstream{path + ".tmp"}.is_open()};
+  remove(path.c_str());
+
+  // then
+  ASSERT_TRUE(saved);
+  ASSERT_TRUE(replaced);
+  ASSERT_EQ(loaded, bytes);
+  ASSERT_FALSE(leftover);
+  ASSERT_TRUE(loadFromFile(path).empty());
+  ASSERT_FALSE(saveToFile(path + ".missing/toh.sav", bytes));
+}
@@ -0,0 +1,124 @@
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "libtoh/game_snapshot.h"
+#include "libtoh/seqlock.h"
+
+using namespace std;
+using namespace toh;
+
+using Tower = vector<size_t>;
+using Play = vector<Position>;
+
+TEST(Seqlock_Tests, Test_Snapshot_Round_Trip) {
+  // given
+  Game game{5};
+  Play plays{Left, Right, Left, Middle, Right};
+  for (auto &&play : plays)
+    game.select(play);
+
+  // when
+  auto snapshot{GameSnapshot::of(game, 2)};
+  auto board{snapshot.board()};
+
+  // then
+  ASSERT_EQ(snapshot.disks(), 5);
+  ASSERT_EQ(snapshot.moves, 2);
+  ASSERT_EQ(snapshot.towers[Left], 0b11100);
+  ASSERT_EQ(snapshot.selection, Right);
+  ASSERT_EQ(board, static_cast<const GameBoard &>(game));
+  ASSERT_EQ(board.getTower(Left), (Tower{5, 4, 3}));
+}
+
+TEST(Seqlock_Tests, Test_Snapshot_Max_Disks) {
+  // given
+  Game largest{MaxSnapshotDisks};
+  Game larger{MaxSnapshotDisks + 1};
+
+  // when
+  auto snapshot{GameSnapshot::of(largest)};
+
+  // then
+  ASSERT_EQ(snapshot.towers[Left], ~uint64_t{0});
+  ASSERT_EQ(snapshot.board(), static_cast<const GameBoard &>(largest));
+  ASSERT_THROW((void)GameSnapshot::of(larger), invalid_argument);
+}
+
+TEST(Seqlock_Tests, Test_Snapshot_Rejects_Corrupt_Towers) {
+  // given
+  auto shared{GameSnapshot::of(Game{3})};
+  shared.towers[Right] = 0b001;
+  GameSnapshot gap{};
+  gap.towers[Middle] = 0b101;
+  GameSnapshot high{};
+  high.towers[Left] = uint64_t{1} << 63;
+  auto selection{GameSnapshot::of(Game{3})};
+  selection.selection = static_cast<Position>(7);
+
+  // then
+  for (auto &&snapshot : {shared, gap, high, selection}) {
+    auto board{snapshot.board()};
+    for (auto &&position : {Left, Middle, Right})
+      ASSERT_TRUE(board.getTower(position).empty());
+  }
+  ASSERT_EQ(GameSnapshot{}.board(), GameBoard{0});
+}
+
+TEST(Seqlock_Tests, Test_Store_And_Load) {
+  // given
+  SeqLock<GameSnapshot> published{};
+  Game game{3};
+  game.select(Left);
+
+  // when
+  published.store(GameSnapshot::of(game, 7));
+
+  // then
+  ASSERT_EQ(published.version(), 2);
+  ASSERT_EQ(published.load(), GameSnapshot::of(game, 7));
+  ASSERT_EQ(published.tryLoad(), GameSnapshot::of(game, 7));
+}
+
+TEST(Seqlock_Tests, Test_Readers_Never_See_Torn_Values) {
+  // given
+  struct Wide {
+    array<uint64_t, 8> words;
+  };
+  SeqLock<Wide> published{};
+  atomic<bool> done{false};
+  atomic<size_t> torn{0};
+
+  // when
+  vector<thread> readers{};
+  for (size_t i{0}; i < 2; i += 1) {
+    readers.emplace_back([&] {
+      uint64_t last{0};
+      while (!done.load()) {
+        auto value{published.load()};
+        for (auto &&word : value.words) {
+          if (word != value.words[0])
+            torn += 1;
+        }
+        // A single writer publishes in order, so a reader never goes back.
+        if (value.words[0] < last)
+          torn += 1;
+        last = value.words[0];
+      }
+    });
+  }
+  for (uint64_t i{1}; i <= 200'000; i += 1) {
+    Wide value{};
+    value.words.fill(i);
+    published.store(value);
+  }
+  done = true;
+  for (auto &&reader : readers)
+    reader.join();
+
+  // then
+  ASSERT_EQ(torn.load(), 0);
+  ASSERT_EQ(published.load().words[7], 200'000);
+  ASSERT_EQ(published.version(), 200'001);
+}
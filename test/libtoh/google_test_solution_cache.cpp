@@ -0,0 +1,147 @@
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "libtoh/solution_cache.h"
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace toh;
+
+using Play = vector<Position>;
+
+TEST(Solution_Cache_Tests, Test_Packed_Solution_Extend) {
+  // given
+  PackedSolution solution{};
+
+  for (size_t disks{1}; disks <= 12; disks += 1) {
+    // when
+    solution = solution.extend();
+
+    // then
+    Play expected{};
+    solveToh(expected, disks, Left, Middle, Right);
+    ASSERT_EQ(solution.size() * 2, expected.size());
+    for (size_t i{0}; i < solution.size(); i += 1) {
+      ASSERT_EQ(solution.at(i) >> 2, expected[2 * i]);
+      ASSERT_EQ(solution.at(i) & 3, expected[2 * i + 1]);
+    }
+  }
+}
+
+TEST(Solution_Cache_Tests, Test_Packed_Solution_Shrink) {
+  // given
+  PackedSolution solution{};
+  for (size_t disks{1}; disks <= 12; disks += 1)
+    solution = solution.extend();
+
+  for (size_t disks{0}; disks <= 12; disks += 1) {
+    // when
+    auto smaller{solution.shrink(disks)};
+
+    // then
+    Play expected{};
+    solveToh(expected, disks, Left, Middle, Right);
+    ASSERT_EQ(smaller.disks(), disks);
+    ASSERT_EQ(smaller.bytes(), (expected.size() / 2 + 1) / 2);
+    for (size_t i{0}; i < smaller.size(); i += 1) {
+      ASSERT_EQ(smaller.at(i), expected[2 * i] << 2 | expected[2 * i + 1]);
+    }
+  }
+}
+
+TEST(Solution_Cache_Tests, Test_Solution_Cache_Relabel) {
+  // given
+  SolutionCache cache{};
+  vector<array<Position, 3>> labellings{
+      {Left, Middle, Right}, {Left, Right, Middle}, {Middle, Left, Right},
+      {Middle, Right, Left}, {Right, Left, Middle}, {Right, Middle, Left}};
+
+  for (auto &&[src, tmp, dst] : labellings) {
+    for (size_t disks : {7, 3, 10, 0, 9, 1}) {
+      // when
+      Play cached{}, expected{};
+      cache.solve(cached, disks, src, tmp, dst);
+      solveToh(expected, disks, src, tmp, dst);
+
+      // then
+      ASSERT_EQ(cached, expected);
+    }
+  }
+}
+
+TEST(Solution_Cache_Tests, Test_Solution_Cache_Appends_Like_Solve_Toh) {
+  // given
+  SolutionCache cache{};
+  vector<char> cached{'x'}, expected{'x'};
+
+  // when
+  cache.solve(cached, 4, 'a', 's', 'd');
+  solveToh(expected, 4, 'a', 's', 'd');
+
+  // then
+  ASSERT_EQ(cached, expected);
+}
+
+TEST(Solution_Cache_Tests, Test_Solution_Cache_Memory_Budget) {
+  // given
+  SolutionCache cache{3700};
+
+  // when
+  cache.acquire(10); // 512 bytes
+  cache.acquire(12); // 2048 bytes
+  cache.acquire(11); // 1024 bytes
+  cache.acquire(10);
+  cache.acquire(9); // 256 bytes, evicts 12
+
+  // then
+  ASSERT_TRUE(cache.contains(9));
+  ASSERT_TRUE(cache.contains(10));
+  ASSERT_TRUE(cache.contains(11));
+  ASSERT_FALSE(cache.contains(12));
+  ASSERT_EQ(cache.memoryUsage(), 512 + 1024 + 256);
+
+  // when
+  cache.setMemoryBudget(600);
+
+  // then
+  ASSERT_TRUE(cache.contains(9));
+  ASSERT_FALSE(cache.contains(10));
+  ASSERT_FALSE(cache.contains(11));
+  ASSERT_EQ(cache.memoryUsage(), 256);
+
+  // when
+  auto large{cache.acquire(13)};
+
+  // then
+  ASSERT_EQ(large->disks(), 13);
+  ASSERT_FALSE(cache.contains(13));
+}
+
+TEST(Solution_Cache_Tests, Test_Solution_Cache_Concurrent) {
+  // given
+  SolutionCache cache{};
+  vector<thread> threads{};
+  vector<bool> matches(8, false);
+
+  // when
+  for (size_t i{0}; i < matches.size(); i += 1) {
+    threads.emplace_back([&, i] {
+      bool all_match{true};
+      for (size_t disks{1}; disks <= 12; disks += 1) {
+        auto size{(disks + i) % 12 + 1};
+        Play cached{}, expected{};
+        cache.solve(cached, size, Right, Left, Middle);
+        solveToh(expected, size, Right, Left, Middle);
+        all_match = all_match && cached == expected;
+      }
+      matches[i] = all_match;
+    });
+  }
+  for (auto &&worker : threads)
+    worker.join();
+
+  // then
+  for (auto &&all_match : matches)
+    ASSERT_TRUE(all_match);
+}
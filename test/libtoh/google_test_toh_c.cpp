@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#include "libtoh/toh_c.h"
+
+using namespace std;
+
+using Moves = vector<uint8_t>;
+
+namespace {
+Moves solve(toh_variant variant, size_t disks) {
+  size_t count{};
+  toh_solve(variant, disks, nullptr, 0, &count);
+  Moves moves(2 * count);
+  toh_solve(variant, disks, moves.data(), count, &count);
+  return moves;
+}
+} // namespace
+
+TEST(Toh_C_Tests, Test_Solve_Length) {
+  // given
+  size_t classic{}, cyclic{}, adjacent{}, bicolor{};
+
+  // when
+  auto status{toh_solve(TOH_CLASSIC, 10, nullptr, 0, &classic)};
+  toh_solve(TOH_CYCLIC, 5, nullptr, 0, &cyclic);
+  toh_solve(TOH_ADJACENT, 5, nullptr, 0, &adjacent);
+  toh_solve(TOH_BICOLOR, 10, nullptr, 0, &bicolor);
+
+  // then
+  ASSERT_EQ(status, TOH_ERROR_BUFFER_TOO_SMALL);
+  ASSERT_EQ(classic, 1023);
+  ASSERT_EQ(cyclic, 163);
+  ASSERT_EQ(adjacent, 242);
+  ASSERT_EQ(bicolor, 1023);
+  ASSERT_EQ(toh_solve(TOH_CLASSIC, 200, nullptr, 0, &classic),
+            TOH_ERROR_ARGUMENT);
+}
+
+TEST(Toh_C_Tests, Test_Solve_And_Apply) {
+  for (auto variant : {TOH_CLASSIC, TOH_CYCLIC, TOH_ADJACENT, TOH_BICOLOR}) {
+    // given
+    auto moves{solve(variant, 8)};
+    auto game{toh_game_create(variant, 8)};
+    size_t applied{};
+
+    // when
+    auto status{toh_game_apply(game, moves.data(), moves.size() / 2, &applied)};
+
+    // then
+    ASSERT_EQ(status, TOH_OK);
+    ASSERT_EQ(applied, moves.size() / 2);
+    ASSERT_EQ(toh_game_is_finished(game), 1);
+    ASSERT_EQ(toh_game_variant(game), variant);
+    toh_game_destroy(game);
+  }
+}
+
+TEST(Toh_C_Tests, Test_Apply_Stops_At_Illegal_Move) {
+  // given
+  auto game{toh_game_create(TOH_CLASSIC, 3)};
+  Moves moves{TOH_LEFT, TOH_RIGHT, TOH_LEFT, TOH_MIDDLE, TOH_LEFT, TOH_RIGHT,
+              TOH_RIGHT, TOH_MIDDLE};
+  size_t applied{};
+
+  // when
+  auto status{toh_game_apply(game, moves.data(), 4, &applied)};
+
+  // then
+  Moves pegs(3);
+  ASSERT_EQ(status, TOH_ERROR_ILLEGAL_MOVE);
+  ASSERT_EQ(applied, 2);
+  ASSERT_EQ(toh_game_pegs(game, pegs.data(), pegs.size()), TOH_OK);
+  ASSERT_EQ(pegs, (Moves{TOH_RIGHT, TOH_MIDDLE, TOH_LEFT}));
+  ASSERT_EQ(toh_game_selection(game), TOH_END);
+  toh_game_destroy(game);
+}
+
+TEST(Toh_C_Tests, Test_Validate_Keeps_Game) {
+  // given
+  auto game{toh_game_create(TOH_CYCLIC, 2)};
+  Moves moves{TOH_LEFT, TOH_MIDDLE, TOH_LEFT, TOH_RIGHT};
+  size_t valid{};
+
+  // when
+  auto status{toh_game_validate(game, moves.data(), 2, &valid)};
+
+  // then
+  Moves pegs(2);
+  ASSERT_EQ(status, TOH_ERROR_ILLEGAL_MOVE);
+  ASSERT_EQ(valid, 1);
+  toh_game_pegs(game, pegs.data(), pegs.size());
+  ASSERT_EQ(pegs, (Moves{TOH_LEFT, TOH_LEFT}));
+  toh_game_destroy(game);
+}
+
+TEST(Toh_C_Tests, Test_Create_From_Pegs) {
+  // given
+  Moves pegs{TOH_MIDDLE, TOH_RIGHT, TOH_RIGHT};
+  Moves invalid{TOH_MIDDLE, TOH_END};
+
+  // when
+  auto game{toh_game_create_from_pegs(TOH_CLASSIC, pegs.data(), pegs.size())};
+  auto copy{toh_game_clone(game)};
+  toh_game_select(game, TOH_MIDDLE);
+  toh_game_select(game, TOH_RIGHT);
+
+  // then
+  Moves result(3);
+  ASSERT_EQ(toh_game_create_from_pegs(TOH_CLASSIC, invalid.data(), 2), nullptr);
+  ASSERT_EQ(toh_game_disks(game), 3);
+  ASSERT_EQ(toh_game_is_finished(game), 1);
+  ASSERT_EQ(toh_game_pegs(game, result.data(), 2), TOH_ERROR_BUFFER_TOO_SMALL);
+  toh_game_pegs(copy, result.data(), result.size());
+  ASSERT_EQ(result, pegs);
+  toh_game_destroy(copy);
+  toh_game_destroy(game);
+}
+
+TEST(Toh_C_Tests, Test_Invalid_Arguments) {
+  // given
+  auto game{toh_game_create(TOH_CLASSIC, 3)};
+  Moves moves{TOH_LEFT, 7};
+
+  // when
+  auto status{toh_game_apply(game, moves.data(), 1, nullptr)};
+
+  // then
+  ASSERT_EQ(status, TOH_ERROR_ILLEGAL_MOVE);
+  ASSERT_EQ(toh_game_select(game, 4), TOH_ERROR_ARGUMENT);
+  ASSERT_EQ(toh_game_apply(nullptr, moves.data(), 1, nullptr),
+            TOH_ERROR_ARGUMENT);
+  ASSERT_EQ(toh_game_disks(nullptr), 0);
+  ASSERT_EQ(toh_api_version(), TOH_C_API_VERSION);
+  toh_game_destroy(game);
+  toh_game_destroy(nullptr);
+}
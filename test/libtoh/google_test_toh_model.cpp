@@ -294,3 +294,100 @@ TEST(Toh_Model_Tests, Test_Game_Play_10) {
   ASSERT_TRUE(game.isSelected(End));
   ASSERT_TRUE(game.isFinished());
 }
+
+template <typename GameType> class Toh_Variant_Tests : public testing::Test {};
+
+using Variants = testing::Types<Game, CyclicGame, AdjacentGame, BicolorGame>;
+TYPED_TEST_SUITE(Toh_Variant_Tests, Variants);
+
+TYPED_TEST(Toh_Variant_Tests, Test_Variant_Solution_Is_Legal) {
+  for (size_t disks{1}; disks <= 6; disks += 1) {
+    // given
+    TypeParam game{disks};
+    Play plays{};
+    TypeParam::RuleType::solve(plays, disks, Left, Middle, Right);
+
+    for (auto play{plays.begin()}; play < plays.end(); advance(play, 2)) {
+      // when
+      game.select(*play);
+      game.select(*next(play));
+
+      // then
+      ASSERT_TRUE(game.isSelected(End));
+    }
+    ASSERT_TRUE(game.isFinished());
+  }
+}
+
+TEST(Toh_Model_Tests, Test_Solve_Cyclic_Moves) {
+  // given
+  vector<size_t> expected{2, 7, 21, 59, 163};
+
+  for (size_t disks{1}; disks <= expected.size(); disks += 1) {
+    // when
+    Play solution{};
+    CyclicRule::solve(solution, disks, Left, Middle, Right);
+
+    // then
+    ASSERT_EQ(solution.size() / 2, expected[disks - 1]);
+  }
+}
+
+TEST(Toh_Model_Tests, Test_Solve_Adjacent_Moves) {
+  size_t expected{1};
+  for (size_t disks{1}; disks <= 6; disks += 1) {
+    // given
+    expected *= 3;
+
+    // when
+    Play solution{};
+    AdjacentRule::solve(solution, disks, Left, Middle, Right);
+
+    // then
+    ASSERT_EQ(solution.size() / 2, expected - 1);
+  }
+}
+
+TEST(Toh_Model_Tests, Test_Cyclic_Game_Counterclockwise) {
+  // given
+  CyclicGame game{1};
+
+  // when
+  game.select(Left);
+  game.select(Right);
+
+  // then
+  ASSERT_EQ(game.getTower(Left), (Tower{1}));
+  ASSERT_TRUE(game.isSelected(Left));
+}
+
+TEST(Toh_Model_Tests, Test_Adjacent_Game_Skip_Middle) {
+  // given
+  AdjacentGame game{1};
+
+  // when
+  game.select(Left);
+  game.select(Right);
+
+  // then
+  ASSERT_EQ(game.getTower(Left), (Tower{1}));
+  ASSERT_TRUE(game.isSelected(Left));
+}
+
+TEST(Toh_Model_Tests, Test_Bicolor_Game_Same_Colour) {
+  // given
+  BicolorGame game{3};
+  game.select(Left);
+  game.select(Right);
+  game.select(Left);
+  game.select(Middle);
+
+  // when
+  game.select(Right);
+  game.select(Left);
+
+  // then
+  ASSERT_EQ(game.getTower(Left), (Tower{3}));
+  ASSERT_EQ(game.getTower(Right), (Tower{1}));
+  ASSERT_TRUE(game.isSelected(Right));
+}
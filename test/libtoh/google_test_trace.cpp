@@ -0,0 +1,83 @@
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "libtoh/toh_model.h"
+#include "libtoh/trace.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+size_t countOccurrences(const string &text, const string &pattern) {
+  size_t count{0};
+  for (auto position{text.find(pattern)}; position != string::npos;
+       position = text.find(pattern, position + 1)) {
+    count += 1;
+  }
+  return count;
+}
+} // namespace
+
+TEST(Trace_Tests, Test_Trace_Empty_Or_Recorded) {
+  // given
+  vector<Position> plays{};
+  solveToh(plays, 3, Left, Middle, Right);
+
+  // when
+  ostringstream out{};
+  trace::writeChromeTrace(out);
+
+  // then
+  auto json{out.str()};
+  ASSERT_EQ(json.front(), '{');
+  ASSERT_NE(json.find("\"traceEvents\":["), string::npos);
+  ASSERT_EQ(json.find("\"name\":\"solveToh\"") != string::npos,
+            trace::isEnabled());
+}
+
+TEST(Trace_Tests, Test_Trace_Zones_From_Threads) {
+  // given
+  ostringstream before{};
+  trace::writeChromeTrace(before);
+
+  // when
+  vector<thread> threads{};
+  for (size_t i{0}; i < 4; i += 1) {
+    threads.emplace_back([] {
+      Game game{1};
+      game.select(Left);
+      game.select(Right);
+    });
+  }
+  for (auto &&worker : threads)
+    worker.join();
+
+  ostringstream after{};
+  trace::writeChromeTrace(after);
+
+  // then
+  auto recorded{countOccurrences(after.str(), "\"name\":\"Game::move\"") -
+                countOccurrences(before.str(), "\"name\":\"Game::move\"")};
+  ASSERT_EQ(recorded, trace::isEnabled() ? 4u : 0u);
+}
+
+TEST(Trace_Tests, Test_Trace_Buffer_Grows_Past_A_Chunk) {
+  // when
+  // Buffers grow in chunks of a thousand events; a fresh thread fills three.
+  thread{[] {
+    for (size_t i{0}; i < 3000; i += 1) {
+      vector<Position> plays{};
+      solveToh(plays, 0, Left, Middle, Right);
+    }
+  }}.join();
+
+  ostringstream out{};
+  trace::writeChromeTrace(out);
+
+  // then
+  ASSERT_GE(countOccurrences(out.str(), "\"name\":\"solveToh\""),
+            trace::isEnabled() ? 3000u : 0u);
+  ASSERT_EQ(out.str().find("\"name\":\"dropped\""), string::npos);
+}
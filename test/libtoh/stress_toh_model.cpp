@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "libtoh/toh_model.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+constexpr string_view Usage{
+    "usage: stress_libtoh [--variant NAME] [--steps N] [--threads N]\n"
+    "                     [--disks N] [--length N] [--seed N]\n"
+    "  --variant  rules to check: classic (default), cyclic, adjacent or\n"
+    "             bicolor\n"
+    "  --steps    total number of selections to check (default 100000000)\n"
+    "  --threads  number of threads (default all cores)\n"
+    "  --disks    largest number of disks of a game (default 10)\n"
+    "  --length   selections per game before starting over (default 4096)\n"
+    "  --seed     seed of the first game (default 1)\n"};
+
+constexpr size_t MaxDisks{64};
+
+struct Options {
+  string_view variant{ClassicRule::Name};
+  size_t steps{100'000'000};
+  size_t threads{max(thread::hardware_concurrency(), 1u)};
+  size_t disks{10};
+  size_t length{4096};
+  size_t seed{1};
+};
+
+optional<Options> parseOptions(int argc, char *argv[]) {
+  Options options{};
+  for (int i{1}; i < argc; i += 2) {
+    string_view arg{argv[i]};
+    if (i + 1 == argc)
+      return nullopt;
+    if (arg == "--variant") {
+      options.variant = argv[i + 1];
+      continue;
+    }
+    size_t *target{arg == "--steps"     ? &options.steps
+                   : arg == "--threads" ? &options.threads
+                   : arg == "--disks"   ? &options.disks
+                   : arg == "--length"  ? &options.length
+                   : arg == "--seed"    ? &options.seed
+                                        : nullptr};
+    if (!target)
+      return nullopt;
+    try {
+      *target = stoul(argv[i + 1]);
+    } catch (const logic_error &) {
+      return nullopt;
+    }
+  }
+  if (options.threads == 0 || options.length == 0 || options.disks == 0 ||
+      options.disks > MaxDisks)
+    return nullopt;
+  return options;
+}
+
+// splitmix64: fast, and every game is reproducible from its seed alone.
+class Random {
+public:
+  explicit Random(uint64_t seed) : m_state{seed} {}
+
+  uint64_t operator()() {
+    auto z{m_state += 0x9E3779B97F4A7C15u};
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+  }
+
+private:
+  uint64_t m_state;
+};
+
+/*
+ * The reference keeps one bit per disk for each tower, so the top of a tower
+ * is its lowest set bit. It shares nothing with the representation of Game
+ * except the rule policy, which decides whether a move is allowed.
+ */
+template <typename Rule> class Reference {
+public:
+  explicit Reference(size_t disks)
+      : m_towers{disks == MaxDisks ? ~uint64_t{0} : (uint64_t{1} << disks) - 1,
+                 0, 0} {}
+
+  void select(Position position) {
+    if (position == End) {
+      m_selection = End;
+    } else if (m_selection == End) {
+      if (m_towers[position])
+        m_selection = position;
+    } else if (m_selection == position) {
+      m_selection = End;
+    } else if (canMove(m_selection, position)) {
+      auto disk{uint64_t{1} << countr_zero(m_towers[m_selection])};
+      m_towers[m_selection] ^= disk;
+      m_towers[position] |= disk;
+      m_selection = End;
+    }
+  }
+
+  size_t height(Position position) const {
+    return static_cast<size_t>(popcount(m_towers[position]));
+  }
+
+  size_t top(Position position) const {
+    return m_towers[position]
+               ? static_cast<size_t>(countr_zero(m_towers[position])) + 1
+               : 0;
+  }
+
+  bool isSelected(Position position) const { return position == m_selection; }
+
+private:
+  bool canMove(Position from, Position to) const {
+    if (!Rule::canMove(from, to))
+      return false;
+    return !m_towers[to] || Rule::canStack(top(from), top(to));
+  }
+
+  array<uint64_t, 3> m_towers;
+  Position m_selection{End};
+};
+
+template <typename GameType>
+bool matches(const GameType &game,
+             const Reference<typename GameType::RuleType> &reference) {
+  for (auto &&position : {Left, Middle, Right}) {
+    auto &tower{game.getTower(position)};
+    if (tower.size() != reference.height(position))
+      return false;
+    if ((tower.empty() ? 0 : tower.back()) != reference.top(position))
+      return false;
+    if (game.isSelected(position) != reference.isSelected(position))
+      return false;
+  }
+  return game.isSelected(End) == reference.isSelected(End);
+}
+
+// Mostly tower selections, with an occasional explicit unselect.
+Position randomChoice(Random &random) {
+  auto value{random() & 0xF};
+  return value == 0xF ? End : static_cast<Position>(value % 3);
+}
+
+struct Trial {
+  uint64_t seed;
+  size_t disks;
+};
+
+Trial trialAt(const Options &options, size_t index) {
+  return {options.seed + index, index % options.disks + 1};
+}
+
+// Returns the number of selections that agreed before the first divergence.
+template <typename GameType>
+size_t replay(size_t disks, const vector<Position> &choices) {
+  GameType game{disks};
+  Reference<typename GameType::RuleType> reference{disks};
+  for (size_t step{0}; step < choices.size(); step += 1) {
+    game.select(choices[step]);
+    reference.select(choices[step]);
+    if (!matches(game, reference))
+      return step;
+  }
+  return choices.size();
+}
+
+template <typename GameType>
+bool diverges(size_t disks, const vector<Position> &choices) {
+  return replay<GameType>(disks, choices) < choices.size();
+}
+
+/*
+ * Delta debugging: drop chunks of selections as long as the rest still
+ * diverges, halving the chunk whenever no chunk can be dropped.
+ */
+template <typename GameType>
+vector<Position> minimize(size_t disks, vector<Position> choices) {
+  for (size_t chunk{max(choices.size() / 2, size_t{1})}; chunk > 0;) {
+    bool dropped{false};
+    for (size_t start{0}; start < choices.size();) {
+      auto candidate{choices};
+      auto end{min(start + chunk, candidate.size())};
+      candidate.erase(candidate.begin() + static_cast<ptrdiff_t>(start),
+                      candidate.begin() + static_cast<ptrdiff_t>(end));
+      if (diverges<GameType>(disks, candidate)) {
+        choices = std::move(candidate);
+        dropped = true;
+      } else {
+        start += chunk;
+      }
+    }
+    if (!dropped)
+      chunk /= 2;
+  }
+  return choices;
+}
+
+struct Failure {
+  Trial trial;
+  size_t step;
+};
+
+template <typename GameType> int stress(const Options &options) {
+  auto trials{(options.steps + options.length - 1) / options.length};
+  atomic<size_t> next{0};
+  atomic<bool> failed{false};
+  mutex lock{};
+  optional<Failure> failure{};
+
+  auto start{steady_clock::now()};
+  vector<thread> workers{};
+  for (size_t t{0}; t < options.threads; t += 1) {
+    workers.emplace_back([&] {
+      size_t index{};
+      while (!failed.load(memory_order_relaxed) &&
+             (index = next.fetch_add(1, memory_order_relaxed)) < trials) {
+        auto trial{trialAt(options, index)};
+        Random random{trial.seed};
+        GameType game{trial.disks};
+        Reference<typename GameType::RuleType> reference{trial.disks};
+        for (size_t step{0}; step < options.length; step += 1) {
+          auto choice{randomChoice(random)};
+          game.select(choice);
+          reference.select(choice);
+          if (!matches(game, reference)) {
+            lock_guard guard{lock};
+            // Keep the earliest trial so reruns report the same divergence.
+            if (!failure || trial.seed < failure->trial.seed)
+              failure = Failure{trial, step};
+            failed.store(true, memory_order_relaxed);
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto &&worker : workers)
+    worker.join();
+  auto seconds{duration<double>(steady_clock::now() - start).count()};
+
+  auto checked{min(next.load(), trials) * options.length};
+  cout << format("{} {} selections on {} threads in {:.3f} (s): {:.0f} "
+                 "(steps/s)\n",
+                 checked, options.variant, options.threads, seconds,
+                 static_cast<double>(checked) / seconds);
+  if (!failure)
+    return 0;
+
+  Random random{failure->trial.seed};
+  vector<Position> choices(failure->step + 1);
+  for (auto &&choice : choices)
+    choice = randomChoice(random);
+  auto reproducer{minimize<GameType>(failure->trial.disks, choices)};
+
+  constexpr array<string_view, 4> Names{"Left", "Middle", "Right", "End"};
+  string list{};
+  for (auto &&choice : reproducer)
+    list += format("{}{}", list.empty() ? "" : ", ", Names[choice]);
+  cout << format("divergence: seed {} with {} disks at step {}\n",
+                 failure->trial.seed, failure->trial.disks, failure->step)
+       << format("reproducer, {} selections on a new {} game of {} disks:\n"
+                 "  {}\n",
+                 reproducer.size(), options.variant, failure->trial.disks,
+                 list);
+  return 1;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  auto options{parseOptions(argc, argv)};
+  if (!options) {
+    cerr << Usage;
+    return 1;
+  }
+
+  if (options->variant == ClassicRule::Name)
+    return stress<Game>(*options);
+  if (options->variant == CyclicRule::Name)
+    return stress<CyclicGame>(*options);
+  if (options->variant == AdjacentRule::Name)
+    return stress<AdjacentGame>(*options);
+  if (options->variant == BicolorRule::Name)
+    return stress<BicolorGame>(*options);
+  cerr << Usage;
+  return 1;
+}
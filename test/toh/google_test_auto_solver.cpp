@@ -0,0 +1,102 @@
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "toh/auto_solver.h"
+
+using namespace std;
+using namespace chrono;
+using namespace toh;
+
+namespace {
+// Waits for the solver to finish, for at most a few seconds.
+template <typename GameType>
+GameSnapshot waitForFinish(const BasicAutoSolver<GameType> &solver) {
+  auto deadline{steady_clock::now() + seconds{5}};
+  auto snapshot{solver.snapshot()};
+  while (!snapshot.board().isFinished() && steady_clock::now() < deadline) {
+    this_thread::sleep_for(milliseconds{1});
+    snapshot = solver.snapshot();
+  }
+  return snapshot;
+}
+} // namespace
+
+TEST(Auto_Solver_Tests, Test_Auto_Solver_Starts_New_Game) {
+  // given
+  BasicAutoSolver<Game> solver{4, hours{1}, [] {}};
+
+  // when
+  auto snapshot{solver.snapshot()};
+
+  // then
+  ASSERT_EQ(snapshot.board(), GameBoard{4});
+  ASSERT_EQ(snapshot.moves, 0);
+}
+
+TEST(Auto_Solver_Tests, Test_Auto_Solver_Finishes_Classic) {
+  // given
+  atomic<size_t> published{0};
+  GameSnapshot snapshot{};
+
+  // when
+  // The snapshot is stored before the callback runs; joining the worker
+  // makes sure the last callback has run too.
+  {
+    BasicAutoSolver<Game> solver{5, milliseconds{0}, [&] { published += 1; }};
+    snapshot = waitForFinish(solver);
+  }
+
+  // then
+  ASSERT_TRUE(snapshot.board().isFinished());
+  ASSERT_EQ(snapshot.moves, 31);
+  ASSERT_EQ(snapshot.selection, End);
+  ASSERT_EQ(published.load(), 62);
+}
+
+TEST(Auto_Solver_Tests, Test_Auto_Solver_Finishes_Adjacent) {
+  // given
+  BasicAutoSolver<AdjacentGame> solver{3, milliseconds{0}, [] {}};
+
+  // when
+  auto snapshot{waitForFinish(solver)};
+
+  // then
+  ASSERT_TRUE(snapshot.board().isFinished());
+  ASSERT_EQ(snapshot.moves, 26);
+}
+
+TEST(Auto_Solver_Tests, Test_Auto_Solver_Stops_Midway) {
+  // given
+  auto start{steady_clock::now()};
+
+  // when
+  {
+    BasicAutoSolver<Game> solver{10, hours{1}, [] {}};
+  }
+
+  // then
+  ASSERT_LT(steady_clock::now() - start, seconds{5});
+}
+
+TEST(Auto_Solver_Tests, Test_Auto_Solver_Plays_Large_Games_Lazily) {
+  // given
+  auto start{steady_clock::now()};
+  GameSnapshot classic{};
+  GameSnapshot cyclic{};
+
+  // when
+  // Neither solution fits in memory, so both must be played as produced.
+  {
+    BasicAutoSolver<Game> classicSolver{64, milliseconds{0}, [] {}};
+    BasicAutoSolver<CyclicGame> cyclicSolver{40, milliseconds{0}, [] {}};
+    this_thread::sleep_for(milliseconds{50});
+    classic = classicSolver.snapshot();
+    cyclic = cyclicSolver.snapshot();
+  }
+
+  // then
+  ASSERT_GT(classic.moves, 0);
+  ASSERT_GT(cyclic.moves, 0);
+  ASSERT_LT(steady_clock::now() - start, seconds{5});
+}
@@ -0,0 +1,137 @@
+#include <regex>
+
+#include "gtest/gtest.h"
+
+#include "toh/diff_toh.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+constexpr size_t ScreenWidth{81};
+constexpr size_t ScreenHeight{20};
+
+// Counts the cursor-addressed updates in the output
+size_t countUpdates(const string &output) {
+  const regex cursor{"\x1b\\[[0-9]+;[0-9]+H"};
+  return static_cast<size_t>(
+      distance(sregex_iterator(begin(output), end(output), cursor),
+               sregex_iterator()));
+}
+} // namespace
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_First_Frame_Repaints) {
+  // given
+  Game game{3};
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+
+  // when
+  auto first{renderer.render()};
+  auto second{renderer.render()};
+
+  // then
+  ASSERT_NE(first.find("\x1b[2J"), string::npos);
+  ASSERT_NE(first.find("(q)->quit"), string::npos);
+  ASSERT_EQ(second, "");
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Move_Updates_Two_Rows) {
+  // given
+  Game game{3};
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+  auto full{renderer.render()};
+
+  // when
+  game.select(Left);
+  auto select{renderer.render()};
+  game.select(Right);
+  auto move{renderer.render()};
+
+  // then
+  ASSERT_EQ(countUpdates(select), 2);
+  ASSERT_EQ(countUpdates(move), 2);
+  ASSERT_EQ(move.find("\x1b[2J"), string::npos);
+  ASSERT_LT(move.size() * 10, full.size());
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Rejected_Move_Drops_Disk) {
+  // given
+  Game game{3};
+  game.select(Left);
+  game.select(Right);
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+  static_cast<void>(renderer.render());
+
+  // when
+  game.select(Left);
+  game.select(Right);
+  auto output{renderer.render()};
+
+  // then
+  ASSERT_TRUE(game.isSelected(Left));
+  ASSERT_EQ(countUpdates(output), 2);
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Resize_Repaints) {
+  // given
+  Game game{3};
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+  static_cast<void>(renderer.render());
+
+  // when
+  renderer.resize(ScreenWidth * 2, ScreenHeight);
+  auto output{renderer.render()};
+
+  // then
+  ASSERT_NE(output.find("\x1b[2J"), string::npos);
+  ASSERT_EQ(renderer.render(), "");
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Finished_Updates_Legend) {
+  // given
+  Game game{1};
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+  static_cast<void>(renderer.render());
+
+  // when
+  game.select(Left);
+  game.select(Right);
+  auto output{renderer.render()};
+
+  // then
+  ASSERT_NE(output.find("Completed in"), string::npos);
+  ASSERT_EQ(countUpdates(output), 3);
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Resume_Elapsed) {
+  // given
+  Game game{3};
+  DiffRenderer renderer{game, ScreenWidth, ScreenHeight};
+
+  // when
+  auto before{renderer.elapsed()};
+  renderer.resume(chrono::seconds{5});
+
+  // then
+  ASSERT_EQ(before.count(), 0);
+  ASSERT_GE(renderer.elapsed(), chrono::seconds{5});
+}
+
+TEST(Diff_Toh_Tests, Test_Diff_Toh_Many_Disks_Fit_Screen) {
+  // given
+  // Bands leave the top row free, so they fill a row less than the screen.
+  Game fits{ScreenHeight - 3};
+  Game many{MaxDisk};
+  DiffRenderer fitting{fits, ScreenWidth, ScreenHeight};
+  DiffRenderer banded{many, ScreenWidth, ScreenHeight};
+
+  // when
+  auto full{banded.render()};
+  many.select(Left);
+  many.select(Right);
+  auto move{banded.render()};
+
+  // then
+  ASSERT_EQ(countUpdates(full), countUpdates(fitting.render()));
+  ASSERT_LE(countUpdates(move), ScreenHeight);
+}
@@ -0,0 +1,76 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "toh/headless_toh.h"
+
+using namespace std;
+using namespace ftxui;
+using namespace toh;
+
+using Tower = vector<size_t>;
+
+TEST(Headless_Toh_Tests, Test_Headless_Toh_Game_3_Play) {
+  // given
+  Game game{3};
+  HeadlessSession session{game};
+  istringstream script{"# solve three disks\n"
+                       "ad as ds ad sa sd ad\n"
+                       "q"};
+
+  // when
+  auto report{session.run(script)};
+
+  // then
+  ASSERT_EQ(report.events, 15);
+  ASSERT_EQ(report.handled, 15);
+  ASSERT_EQ(game.getTower(Left), (Tower{}));
+  ASSERT_EQ(game.getTower(Middle), (Tower{}));
+  ASSERT_EQ(game.getTower(Right), (Tower{3, 2, 1}));
+  ASSERT_TRUE(game.isFinished());
+}
+
+TEST(Headless_Toh_Tests, Test_Headless_Toh_Stops_At_Quit) {
+  // given
+  Game game{3};
+  HeadlessSession session{game, false};
+  istringstream script{"adqas"};
+
+  // when
+  auto report{session.run(script)};
+
+  // then
+  ASSERT_EQ(report.events, 3);
+  ASSERT_EQ(game.getTower(Left), (Tower{3, 2}));
+  ASSERT_EQ(game.getTower(Right), (Tower{1}));
+  ASSERT_TRUE(game.isSelected(End));
+}
+
+TEST(Headless_Toh_Tests, Test_Headless_Toh_Unhandled_Keys) {
+  // given
+  Game game{3};
+  HeadlessSession session{game, false};
+  istringstream script{"xa+"};
+
+  // when
+  auto report{session.run(script)};
+
+  // then
+  ASSERT_EQ(report.events, 3);
+  ASSERT_EQ(report.handled, 2);
+  ASSERT_EQ(game.getTower(Left), (Tower{4, 3, 2, 1}));
+}
+
+TEST(Headless_Toh_Tests, Test_Headless_Toh_Renders_Off_Screen) {
+  // given
+  Game game{1};
+  HeadlessSession session{game, true, 81, 20};
+  istringstream script{"ad"};
+
+  // when
+  session.run(script);
+
+  // then
+  auto frame{session.canvas().ToString()};
+  ASSERT_NE(frame.find("103m"), string::npos);
+}
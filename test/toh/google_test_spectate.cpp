@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include "toh/spectate.h"
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace toh;
+
+namespace {
+// Segments are shared by the whole machine; keep concurrent runs apart.
+string uniqueName(string_view test) {
+#if !defined(_WIN32)
+  return format("test-{}-{}", test, getpid());
+#else
+  return string{test};
+#endif
+}
+} // namespace
+
+TEST(Spectate_Tests, Test_Spectator_Sees_Published_Game) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "needs POSIX shared memory";
+#endif
+  // given
+  auto name{uniqueName("publish")};
+  auto publisher{SpectatePublisher::create(name)};
+  ASSERT_TRUE(publisher);
+  Game game{3};
+  publisher->publish(game);
+  auto view{SpectateView::open(name)};
+  ASSERT_TRUE(view);
+  auto version{view->version()};
+
+  // when
+  game.select(Left);
+  publisher->publish(game);
+  game.select(Right);
+  publisher->publish(game);
+  publisher->publish(game);
+
+  // then
+  auto snapshot{view->snapshot()};
+  ASSERT_EQ(snapshot.board(), static_cast<const GameBoard &>(game));
+  ASSERT_EQ(snapshot.moves, 1);
+  ASSERT_EQ(view->version(), version + 2);
+  ASSERT_FALSE(view->isClosed());
+}
+
+TEST(Spectate_Tests, Test_Spectator_Sees_Player_Leave) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "needs POSIX shared memory";
+#endif
+  // given
+  auto name{uniqueName("close")};
+  auto publisher{SpectatePublisher::create(name)};
+  ASSERT_TRUE(publisher);
+  publisher->publish(Game{4});
+  auto view{SpectateView::open(name)};
+  ASSERT_TRUE(view);
+
+  // when
+  publisher.reset();
+
+  // then
+  ASSERT_TRUE(view->isClosed());
+  ASSERT_EQ(view->snapshot().disks(), 4);
+  ASSERT_FALSE(SpectateView::open(name));
+}
+
+TEST(Spectate_Tests, Test_Publishers_Of_The_Same_Name) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "needs POSIX shared memory";
+#else
+  // given
+  auto name{uniqueName("twice")};
+  auto first{SpectatePublisher::create(name)};
+  ASSERT_TRUE(first);
+  first->publish(Game{3});
+
+  // when
+  auto second{SpectatePublisher::create(name)};
+  auto view{SpectateView::open(name)};
+  first.reset();
+  auto third{SpectatePublisher::create(name)};
+
+  // then
+  ASSERT_FALSE(second);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view->snapshot().disks(), 3);
+  ASSERT_TRUE(view->isClosed());
+  ASSERT_TRUE(third);
+#endif
+}
+
+TEST(Spectate_Tests, Test_Publisher_Replaces_Crashed_Player) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "needs POSIX shared memory";
+#else
+  // given
+  auto name{uniqueName("crashed")};
+  auto child{fork()};
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // Exits without closing nor unlinking, as a crash would.
+    auto leaked{SpectatePublisher::create(name).release()};
+    _exit(leaked ? 0 : 1);
+  }
+  int status{};
+  waitpid(child, &status, 0);
+  ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  // when
+  auto publisher{SpectatePublisher::create(name)};
+
+  // then
+  ASSERT_TRUE(publisher);
+  auto view{SpectateView::open(name)};
+  ASSERT_TRUE(view);
+  ASSERT_FALSE(view->isClosed());
+#endif
+}
+
+TEST(Spectate_Tests, Test_Publisher_Keeps_A_Name_Taken_Over) {
+#if defined(_WIN32)
+  GTEST_SKIP() << "needs POSIX shared memory";
+#else
+  // given
+  auto name{uniqueName("taken")};
+  auto first{SpectatePublisher::create(name)};
+  ASSERT_TRUE(first);
+  shm_unlink(spectateSegmentName(name).c_str());
+  auto second{SpectatePublisher::create(name)};
+  ASSERT_TRUE(second);
+  second->publish(Game{5});
+
+  // when
+  first.reset();
+
+  // then
+  auto view{SpectateView::open(name)};
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view->snapshot().disks(), 5);
+  ASSERT_FALSE(view->isClosed());
+#endif
+}
+
+TEST(Spectate_Tests, Test_Spectate_Missing_Game) {
+  // given
+  auto name{uniqueName("missing")};
+
+  // then
+  ASSERT_FALSE(SpectateView::open(name));
+}
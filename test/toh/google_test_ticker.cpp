@@ -0,0 +1,76 @@
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "toh/ticker.h"
+
+using namespace std;
+using namespace chrono;
+
+namespace {
+constexpr auto Period{milliseconds{5}};
+} // namespace
+
+TEST(Ticker_Tests, Test_Ticker_Idle_By_Default) {
+  // given
+  atomic<size_t> ticks{0};
+  Ticker ticker{[&] { ticks += 1; }, Period};
+
+  // when
+  this_thread::sleep_for(Period * 10);
+
+  // then
+  ASSERT_FALSE(ticker.isRunning());
+  ASSERT_EQ(ticks.load(), 0);
+}
+
+TEST(Ticker_Tests, Test_Ticker_Ticks_While_Running) {
+  // given
+  atomic<size_t> ticks{0};
+  Ticker ticker{[&] { ticks += 1; }, Period};
+
+  // when
+  ticker.setRunning(true);
+  this_thread::sleep_for(Period * 20);
+
+  // then
+  ASSERT_TRUE(ticker.isRunning());
+  ASSERT_GE(ticks.load(), 3);
+}
+
+TEST(Ticker_Tests, Test_Ticker_Stops_Ticking) {
+  // given
+  atomic<size_t> ticks{0};
+  Ticker ticker{[&] { ticks += 1; }, Period};
+  ticker.setRunning(true);
+  this_thread::sleep_for(Period * 4);
+
+  // when
+  ticker.setRunning(false);
+  this_thread::sleep_for(Period * 2);
+  auto stopped{ticks.load()};
+  this_thread::sleep_for(Period * 10);
+
+  // then
+  ASSERT_EQ(ticks.load(), stopped);
+}
+
+TEST(Ticker_Tests, Test_Ticker_Stops_From_Tick) {
+  // given
+  atomic<size_t> ticks{0};
+  Ticker *self{nullptr};
+  Ticker ticker{[&] {
+                  ticks += 1;
+                  self->setRunning(false);
+                },
+                Period};
+  self = &ticker;
+
+  // when
+  ticker.setRunning(true);
+  this_thread::sleep_for(Period * 10);
+
+  // then
+  ASSERT_EQ(ticks.load(), 1);
+  ASSERT_FALSE(ticker.isRunning());
+}
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+#include "toh/tower_layout.h"
+
+using namespace std;
+
+TEST(Tower_Layout_Tests, Test_Tower_Layout_Small_Game_Unscaled) {
+  // given
+  TowerLayout layout{10, 25, 16};
+  vector<size_t> tower{10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+  // then
+  for (size_t disk{1}; disk <= 10; disk += 1)
+    ASSERT_EQ(layout.halfWidth(disk), disk);
+  ASSERT_EQ(layout.halfWidth(0), 0);
+  ASSERT_EQ(layout.visibleRows(tower), tower);
+}
+
+TEST(Tower_Layout_Tests, Test_Tower_Layout_Widths_Scale) {
+  // given
+  TowerLayout layout{MaxDisk, 25, 16};
+
+  // then
+  for (size_t disk{1}; disk <= MaxDisk; disk += 1) {
+    ASSERT_GE(layout.halfWidth(disk), 1);
+    ASSERT_LE(layout.halfWidth(disk), 12);
+    ASSERT_GE(layout.halfWidth(disk), layout.halfWidth(disk - 1));
+  }
+  ASSERT_EQ(layout.halfWidth(MaxDisk), 12);
+  ASSERT_EQ((TowerLayout{MaxDisk, 1, 16}.halfWidth(MaxDisk)), 0);
+}
+
+TEST(Tower_Layout_Tests, Test_Tower_Layout_Bands) {
+  // given
+  TowerLayout layout{MaxDisk, 25, 16};
+  vector<size_t> tower(MaxDisk);
+  iota(rbegin(tower), rend(tower), size_t{1});
+
+  // when
+  auto rows{layout.visibleRows(tower)};
+
+  // then
+  ASSERT_EQ(rows.size(), 15);
+  ASSERT_EQ(rows.front(), MaxDisk);
+  ASSERT_TRUE(is_sorted(rbegin(rows), rend(rows)));
+  ASSERT_EQ(adjacent_find(begin(rows), end(rows)), end(rows));
+  ASSERT_EQ(rows.back(), 1);
+}
+
+TEST(Tower_Layout_Tests, Test_Tower_Layout_Top_Disk_Visible) {
+  // given
+  TowerLayout layout{MaxDisk, 25, 20};
+  vector<size_t> tower(MaxDisk);
+  iota(rbegin(tower), rend(tower), size_t{1});
+  vector<size_t> partial(begin(tower), begin(tower) + 40);
+
+  // when
+  auto rows{layout.visibleRows(tower)};
+  auto partialRows{layout.visibleRows(partial)};
+
+  // then
+  ASSERT_LT(rows.size(), layout.rows);
+  ASSERT_EQ(rows.back(), 1);
+  ASSERT_LT(partialRows.size(), layout.rows);
+  ASSERT_EQ(partialRows.front(), MaxDisk);
+  ASSERT_EQ(partialRows.back(), partial.back());
+}
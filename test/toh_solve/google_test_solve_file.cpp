@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "toh_solve/solve_file.h"
+
+using namespace std;
+using namespace toh;
+
+namespace {
+string tempPath(const string &name) {
+  auto path{testing::TempDir() + name};
+  remove(path.c_str());
+  return path;
+}
+
+// The index of the first move that differs from the optimal path, or the
+// length of the path if none does.
+uint64_t firstWrong(const SolveFile &file) {
+  for (uint64_t i{0}; i < optimalLength(file.disks()); i += 1)
+    if (file.move(i) != optimalMove(file.disks(), i))
+      return i;
+  return optimalLength(file.disks());
+}
+} // namespace
+
+TEST(Solve_File_Tests, Test_Workers_Write_The_Solution) {
+  // given
+  auto path{tempPath("toh_solve_workers.toh")};
+  auto file{SolveFile::create(path, 13, 7)};
+  ASSERT_TRUE(file);
+
+  // when
+  auto complete{solveInProcesses(*file, 3)};
+
+  // then
+  ASSERT_TRUE(complete);
+  ASSERT_EQ(firstWrong(*file), optimalLength(13));
+  file.reset();
+  auto reopened{SolveFile::open(path)};
+  ASSERT_TRUE(reopened);
+  ASSERT_TRUE(reopened->isComplete());
+  ASSERT_EQ(firstWrong(*reopened), optimalLength(13));
+  remove(path.c_str());
+}
+
+TEST(Solve_File_Tests, Test_Resume_From_Checkpoint) {
+  // given
+  auto path{tempPath("toh_solve_resume.toh")};
+  auto file{SolveFile::create(path, 10, 4)};
+  ASSERT_TRUE(file);
+  ASSERT_EQ(file->claim(), 0);
+  ASSERT_EQ(file->solve(0, 101), 101);
+  file.reset();
+
+  // when
+  auto resumed{SolveFile::open(path)};
+  ASSERT_TRUE(resumed);
+  auto progress{resumed->progress(0)};
+  auto unwritten{resumed->move(101)};
+  auto complete{solveInProcesses(*resumed, 2)};
+
+  // then
+  ASSERT_EQ(progress, 101);
+  ASSERT_EQ(unwritten, Move{});
+  ASSERT_TRUE(complete);
+  ASSERT_EQ(firstWrong(*resumed), optimalLength(10));
+  resumed->rewind();
+  ASSERT_EQ(resumed->claim(), nullopt);
+  remove(path.c_str());
+}
+
+TEST(Solve_File_Tests, Test_Invalid_Files_Are_Refused) {
+  // given
+  auto path{tempPath("toh_solve_invalid.toh")};
+  ofstream{path} << "not a solve file";
+
+  // when, then
+  ASSERT_FALSE(SolveFile::open(path));
+  ASSERT_FALSE(SolveFile::create(path, 10, 4));
+  ASSERT_FALSE(SolveFile::open(path + ".missing"));
+  remove(path.c_str());
+  ASSERT_FALSE(SolveFile::create(path, 10, 0));
+  ASSERT_FALSE(SolveFile::create(path, 10, SolveHeader::MaxShards + 1));
+  ASSERT_FALSE(SolveFile::create(path, MaxPathDisks, 4));
+  ASSERT_FALSE(SolveFile::open(path));
+}